@@ -0,0 +1,191 @@
+#ifndef LW4_ARENA_H
+#define LW4_ARENA_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <vector>
+
+// Per-thread bump allocator for the temporaries of one top-level curve operation. Arena::run(f) calls f with the
+// thread's arena active: every ArenaAllocator allocation on this thread (the coefficients of each GF2mElement,
+// BigInt limbs, prefix arrays of batch inversions) then comes from blocks the arena keeps between operations,
+// and small freed blocks are reused from per-size free lists. When f returns, its result is copied out onto the
+// heap and the arena is rewound, so a long batch of scalar multiplications settles at a fixed set of blocks and
+// does no malloc/free per temporary. Nested runs use the outer scope. Nothing allocated inside a run may be kept
+// past it except through its result.
+class Arena {
+private:
+    static const size_t BLOCK_SIZE = size_t(1) << 20;
+    static const size_t ALIGNMENT = 16;
+    static const size_t CLASSES = 32; // free lists for sizes 16, 32, .., 496
+
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    std::vector<Block> blocks;
+    size_t current = 0; // block being filled
+    size_t offset = 0;  // bytes used in it
+    int depth = 0;
+    size_t peak = 0;
+    std::array<void*, CLASSES> freeLists{};
+
+    size_t used() const {
+        size_t total = offset;
+        for (size_t i = 0; i < current && i < blocks.size(); ++i) total += blocks[i].size;
+        return total;
+    }
+
+    // rewinds to the first block, keeping every block for the next operation
+    void reset() {
+        peak = std::max(peak, used());
+        current = 0;
+        offset = 0;
+        freeLists.fill(nullptr);
+    }
+
+    static size_t round(size_t bytes) {
+        return (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+public:
+    Arena() = default;
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    static Arena& local() {
+        thread_local Arena arena;
+        return arena;
+    }
+
+    bool active() const { return depth > 0; }
+
+    // bytes held in blocks, and the most a single operation has used
+    size_t reserved() const {
+        size_t total = 0;
+        for (const Block& b : blocks) total += b.size;
+        return total;
+    }
+
+    size_t peakUsed() const { return std::max(peak, used()); }
+
+    void* allocate(size_t bytes) {
+        bytes = round(bytes);
+        size_t size = bytes / ALIGNMENT;
+        if (size < CLASSES && freeLists[size]) {
+            void* p = freeLists[size];
+            freeLists[size] = *static_cast<void**>(p);
+            return p;
+        }
+        while (current < blocks.size() && offset + bytes > blocks[current].size) {
+            ++current;
+            offset = 0;
+        }
+        if (current == blocks.size()) {
+            size_t size = std::max(BLOCK_SIZE, bytes);
+            blocks.push_back({std::unique_ptr<char[]>(new char[size]), size});
+            offset = 0;
+        }
+        void* p = blocks[current].data.get() + offset;
+        offset += bytes;
+        return p;
+    }
+
+    // small blocks go back on a free list until the rewind, which keeps the working set of a long operation in
+    // cache; larger ones wait for the rewind
+    void release(void* p, size_t bytes) {
+        size_t size = round(bytes) / ALIGNMENT;
+        if (size >= CLASSES) return;
+        *static_cast<void**>(p) = freeLists[size];
+        freeLists[size] = p;
+    }
+
+    template <typename F>
+    static auto run(F&& f) -> decltype(f()) {
+        Arena& arena = local();
+        if (arena.active()) return f();
+        using Result = decltype(f());
+        std::optional<Result> inner;
+        {
+            struct Scope {
+                Arena& arena;
+                explicit Scope(Arena& arena) : arena(arena) { ++arena.depth; }
+                ~Scope() { --arena.depth; }
+            } scope(arena);
+            try {
+                inner.emplace(f());
+            } catch (...) {
+                arena.reset();
+                throw;
+            }
+        }
+        // copied while no scope is active, so the copy lives on the heap
+        Result result = *inner;
+        inner.reset();
+        arena.reset();
+        return result;
+    }
+};
+
+// Allocates from the thread's arena inside Arena::run and from the heap otherwise. A 16-byte header records the
+// owning arena (none for the heap) and the size, so memory can be released from any thread: arena memory released
+// by its own thread during the run is recycled, anything else waits for the rewind.
+template <typename T>
+class ArenaAllocator {
+private:
+    static const size_t HEADER = 16;
+    static_assert(alignof(T) <= HEADER, "ArenaAllocator aligns to 16 bytes");
+
+    struct Header {
+        Arena* owner;
+        size_t bytes;
+    };
+
+public:
+    using value_type = T;
+
+    ArenaAllocator() = default;
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>&) {}
+
+    T* allocate(size_t n) {
+        size_t bytes = HEADER + n * sizeof(T);
+        Arena& arena = Arena::local();
+        Header* header;
+        if (arena.active()) {
+            header = static_cast<Header*>(arena.allocate(bytes));
+            header->owner = &arena;
+        } else {
+            header = static_cast<Header*>(::operator new(bytes));
+            header->owner = nullptr;
+        }
+        header->bytes = bytes;
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(header) + HEADER);
+    }
+
+    void deallocate(T* q, size_t) {
+        Header* header = reinterpret_cast<Header*>(reinterpret_cast<char*>(q) - HEADER);
+        if (!header->owner) {
+            ::operator delete(header);
+            return;
+        }
+        Arena& arena = Arena::local();
+        if (header->owner == &arena && arena.active()) arena.release(header, header->bytes);
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>&) const { return true; }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>&) const { return false; }
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif //LW4_ARENA_H
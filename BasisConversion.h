@@ -0,0 +1,205 @@
+#ifndef LW4_BASISCONVERSION_H
+#define LW4_BASISCONVERSION_H
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "BitMatrix.h"
+#include "GF2mElement.h"
+#include "GF2mPalindromic.h"
+#include "GF2mPolynomial.h"
+
+// Change-of-basis matrices between the type II ONB and the polynomial basis 1, beta, ..., beta^(m-1) of the
+// same normal element, from the NIST polynomial basis GF(2)[x]/(x^233 + x^74 + 1) of B-233 and K-233, and the
+// (permutation) matrix to the palindromic form. Coordinates are packed bits in
+// the GF2mElement::toWords order; batches of eight go through the affine-instruction kernel of BitMatrix.
+class BasisConversion {
+private:
+    using Words = std::array<uint64_t, 4>;
+
+    static std::vector<uint64_t> toVector(const Words& words) {
+        return std::vector<uint64_t>(words.begin(), words.end());
+    }
+
+    static Words toArray(const std::vector<uint64_t>& bits) {
+        Words words{};
+        for (size_t w = 0; w < words.size() && w < bits.size(); ++w) words[w] = bits[w];
+        return words;
+    }
+
+    static std::vector<Words> convert(const BitMatrix& matrix, const std::vector<Words>& coordinates) {
+        std::vector<std::vector<uint64_t>> xs;
+        xs.reserve(coordinates.size());
+        for (const Words& c : coordinates) xs.push_back(toVector(c));
+        std::vector<Words> result;
+        result.reserve(xs.size());
+        for (const auto& y : matrix.applyBatch(xs)) result.push_back(toArray(y));
+        return result;
+    }
+
+    // NIST reduction trinomial x^233 + x^74 + 1
+    static const int TRINOMIAL_MIDDLE = 74;
+
+    // a polynomial over GF(2^m) reduced modulo the trinomial, m coefficients; x^k = x^(k - m + 74) + x^(k - m)
+    static std::vector<GF2mElement> reduce(std::vector<GF2mElement> p) {
+        const int m = GF2mElement::getM();
+        for (int k = static_cast<int>(p.size()) - 1; k >= m; --k) {
+            if (p[k].isZero()) continue;
+            p[k - m + TRINOMIAL_MIDDLE] = p[k - m + TRINOMIAL_MIDDLE] + p[k];
+            p[k - m] = p[k - m] + p[k];
+        }
+        p.resize(m, GF2mElement::zero());
+        return p;
+    }
+
+    static std::vector<GF2mElement> multiplyMod(const std::vector<GF2mElement>& a, const std::vector<GF2mElement>& b) {
+        return reduce((GF2mPolynomial(a) * GF2mPolynomial(b)).getCoefficients());
+    }
+
+    // a root theta of the trinomial. It splits over GF(2^233), so A = GF(2^233)[x]/(trinomial) is GF(2^233)^233
+    // through evaluation at its roots, and Tr(delta x) is the idempotent of the roots with Tr(delta theta) = 1.
+    // Products of such idempotents (or their complements) for random delta shrink e until it picks a single root;
+    // then x e = theta e.
+    static GF2mElement findTrinomialRoot() {
+        const int m = GF2mElement::getM();
+        // x^(2^j) modulo the trinomial has its coefficients in GF(2), so Tr(delta x) = sum_j delta^(2^j) x^(2^j)
+        // is only additions of conjugates of delta
+        std::vector<std::vector<char>> frobenius(m, std::vector<char>(m, 0));
+        std::vector<char> power(2 * m, 0);
+        power[1] = 1;
+        for (int j = 0; j < m; ++j) {
+            std::copy(power.begin(), power.begin() + m, frobenius[j].begin());
+            std::vector<char> square(2 * m, 0);
+            for (int k = 0; k < m; ++k) square[2 * k] = power[k];
+            for (int k = 2 * m - 1; k >= m; --k) {
+                square[k - m + TRINOMIAL_MIDDLE] ^= square[k];
+                square[k - m] ^= square[k];
+            }
+            std::fill(square.begin() + m, square.end(), 0);
+            power = std::move(square);
+        }
+
+        std::mt19937_64 rng(m);
+        std::vector<GF2mElement> e(m, GF2mElement::zero());
+        e[0] = GF2mElement::one();
+        while (true) {
+            GF2mElement delta = GF2mElement::fromWords({rng(), rng(), rng(), rng()});
+            std::vector<GF2mElement> trace(m, GF2mElement::zero());
+            for (int j = 0; j < m; ++j) {
+                GF2mElement conjugate = delta.frobenius(j);
+                for (int k = 0; k < m; ++k) {
+                    if (frobenius[j][k]) trace[k] = trace[k] + conjugate;
+                }
+            }
+            std::vector<GF2mElement> picked = multiplyMod(e, trace);
+            bool empty = true;
+            for (const GF2mElement& c : picked) empty = empty && c.isZero();
+            if (empty) {
+                for (int k = 0; k < m; ++k) picked[k] = picked[k] + e[k];
+            }
+            e = std::move(picked);
+
+            std::vector<GF2mElement> shifted(m + 1, GF2mElement::zero());
+            std::copy(e.begin(), e.end(), shifted.begin() + 1);
+            shifted = reduce(std::move(shifted));
+            int lead = 0;
+            while (e[lead].isZero()) ++lead;
+            GF2mElement theta = shifted[lead] * e[lead].inverse();
+            bool single = true;
+            for (int k = 0; k < m && single; ++k) single = shifted[k] == theta * e[k];
+            if (single) return theta;
+        }
+    }
+
+public:
+    // column k is beta^k in normal coordinates; multiplying by beta is the sparse basis-element product
+    static const BitMatrix& polynomialToNormal() {
+        static const BitMatrix matrix = [] {
+            const int m = GF2mElement::getM();
+            std::vector<std::vector<uint64_t>> columns;
+            GF2mElement power = GF2mElement::one();
+            for (int k = 0; k < m; ++k) {
+                columns.push_back(toVector(power.toWords()));
+                power = power.multiplyByBasisElement(0);
+            }
+            return BitMatrix::fromColumns(m, columns);
+        }();
+        return matrix;
+    }
+
+    static const BitMatrix& normalToPolynomial() {
+        static const BitMatrix matrix = [] {
+            BitMatrix inverse(GF2mElement::getM(), GF2mElement::getM());
+            polynomialToNormal().invert(inverse); // beta generates GF(2^233), so its powers are independent
+            return inverse;
+        }();
+        return matrix;
+    }
+
+    static const GF2mElement& trinomialRoot() {
+        static const GF2mElement root = findTrinomialRoot();
+        return root;
+    }
+
+    // column k is theta^k for the root theta of the NIST trinomial
+    static const BitMatrix& trinomialToNormal() {
+        static const BitMatrix matrix = [] {
+            const int m = GF2mElement::getM();
+            std::vector<std::vector<uint64_t>> columns;
+            GF2mElement power = GF2mElement::one();
+            for (int k = 0; k < m; ++k) {
+                columns.push_back(toVector(power.toWords()));
+                power = power * trinomialRoot();
+            }
+            return BitMatrix::fromColumns(m, columns);
+        }();
+        return matrix;
+    }
+
+    static const BitMatrix& normalToPalindromic() {
+        static const BitMatrix matrix = [] {
+            const int m = GF2mElement::getM();
+            std::vector<std::vector<uint64_t>> columns;
+            for (int c = 0; c < m; ++c) {
+                Words unit{};
+                unit[c / 64] = uint64_t(1) << (c % 64);
+                columns.push_back(toVector(PalindromicMultiplier::toPalindromic(unit)));
+            }
+            return BitMatrix::fromColumns(m, columns);
+        }();
+        return matrix;
+    }
+
+    // bit k of the result is the coefficient of beta^k
+    static std::vector<Words> toPolynomial(const std::vector<GF2mElement>& elements) {
+        std::vector<Words> coordinates;
+        coordinates.reserve(elements.size());
+        for (const GF2mElement& e : elements) coordinates.push_back(e.toWords());
+        return convert(normalToPolynomial(), coordinates);
+    }
+
+    static std::vector<GF2mElement> fromPolynomial(const std::vector<Words>& coordinates) {
+        std::vector<GF2mElement> elements;
+        elements.reserve(coordinates.size());
+        for (const Words& c : convert(polynomialToNormal(), coordinates)) elements.push_back(GF2mElement::fromWords(c));
+        return elements;
+    }
+
+    // bit k of the input is the coefficient of x^k in the NIST polynomial basis
+    static std::vector<GF2mElement> fromTrinomial(const std::vector<Words>& coordinates) {
+        std::vector<GF2mElement> elements;
+        elements.reserve(coordinates.size());
+        for (const Words& c : convert(trinomialToNormal(), coordinates)) elements.push_back(GF2mElement::fromWords(c));
+        return elements;
+    }
+
+    static std::vector<Words> toPalindromic(const std::vector<GF2mElement>& elements) {
+        std::vector<Words> coordinates;
+        coordinates.reserve(elements.size());
+        for (const GF2mElement& e : elements) coordinates.push_back(e.toWords());
+        return convert(normalToPalindromic(), coordinates);
+    }
+};
+
+#endif //LW4_BASISCONVERSION_H
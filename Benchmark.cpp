@@ -0,0 +1,56 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "ScalabilityBenchmark.h"
+
+// usage: Benchmark [csv|json] [max batch] [max threads] [ms per point] [output file] [powercap root]
+// sweeps every multiplication and inversion backend, random element generation, exponentiation and the K-233
+// scalar multiplications over 1 .. max threads and batches of 1 .. max batch elements, printing progress to
+// stderr and the results as CSV or JSON (stdout unless a file is given), with joules per operation where the
+// RAPL counters are readable
+int main(int argc, char* argv[]) {
+    std::string format = argc > 1 ? argv[1] : "csv";
+    long maxBatch = argc > 2 ? std::atol(argv[2]) : 1000000;
+    int maxThreads = argc > 3 ? std::atoi(argv[3]) : static_cast<int>(std::thread::hardware_concurrency());
+    double minSeconds = (argc > 4 ? std::atof(argv[4]) : 50) / 1000;
+    if (format != "csv" && format != "json") {
+        std::cerr << "Unknown format " << format << " (csv or json)" << std::endl;
+        return 1;
+    }
+    if (maxBatch < 1 || maxThreads < 1) {
+        std::cerr << "max batch and max threads must be positive" << std::endl;
+        return 1;
+    }
+
+    EnergyMeter meter(argc > 6 ? argv[6] : "/sys/class/powercap");
+    if (meter.available()) {
+        std::cerr << "Energy domains:";
+        for (const auto& d : meter.getDomains()) std::cerr << " " << d.name;
+        std::cerr << std::endl;
+    } else {
+        std::cerr << "No readable RAPL energy counters, reporting throughput only" << std::endl;
+    }
+
+    ScalabilityBenchmark benchmark(static_cast<size_t>(maxBatch), meter);
+    auto results = benchmark.sweep(maxThreads, minSeconds, [](const BenchmarkResult& r) {
+        std::cerr << r.backend << " " << r.operation << ", " << r.threads << " threads, batch " << r.batch << ": "
+                  << r.opsPerSecond << " ops/s, speedup " << r.speedup;
+        if (r.energy) std::cerr << ", " << r.joulesPerOp << " J/op";
+        std::cerr << std::endl;
+    });
+
+    std::ofstream file;
+    if (argc > 5 && std::string(argv[5]) != "-") {
+        file.open(argv[5]);
+        if (!file) {
+            std::cerr << "Cannot write " << argv[5] << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = file.is_open() ? file : std::cout;
+    if (format == "json") ScalabilityBenchmark::writeJson(out, results);
+    else ScalabilityBenchmark::writeCsv(out, results);
+    return 0;
+}
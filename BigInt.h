@@ -0,0 +1,205 @@
+#ifndef LW4_BIGINT_H
+#define LW4_BIGINT_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Arena.h"
+
+// Signed integers of a few hundred bits for scalar recoding: sign and magnitude, 64-bit limbs, least
+// significant first. Only the operations the tau-adic code needs; nothing here is constant time.
+class BigInt {
+private:
+    using Limbs = ArenaVector<uint64_t>; // arena-backed inside Arena::run
+
+    bool negative = false;
+    Limbs limbs; // no leading zero limbs; zero is the empty vector
+
+    void trim() {
+        while (!limbs.empty() && !limbs.back()) limbs.pop_back();
+        if (limbs.empty()) negative = false;
+    }
+
+    static int compareMagnitude(const Limbs& a, const Limbs& b) {
+        if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+        for (size_t i = a.size(); i-- > 0;) {
+            if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    static Limbs addMagnitude(const Limbs& a, const Limbs& b) {
+        const Limbs& longer = a.size() >= b.size() ? a : b;
+        const Limbs& shorter = a.size() >= b.size() ? b : a;
+        Limbs sum(longer.size() + 1, 0);
+        unsigned __int128 carry = 0;
+        for (size_t i = 0; i < longer.size(); ++i) {
+            carry += static_cast<unsigned __int128>(longer[i]) + (i < shorter.size() ? shorter[i] : 0);
+            sum[i] = static_cast<uint64_t>(carry);
+            carry >>= 64;
+        }
+        sum[longer.size()] = static_cast<uint64_t>(carry);
+        return sum;
+    }
+
+    // |a| - |b| for |a| >= |b|
+    static Limbs subtractMagnitude(const Limbs& a, const Limbs& b) {
+        Limbs difference(a.size(), 0);
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < a.size(); ++i) {
+            uint64_t y = i < b.size() ? b[i] : 0;
+            uint64_t d = a[i] - y - borrow;
+            borrow = (a[i] < y || (a[i] == y && borrow)) ? 1 : 0;
+            difference[i] = d;
+        }
+        return difference;
+    }
+
+    static BigInt signedSum(bool negA, const Limbs& a, bool negB, const Limbs& b) {
+        BigInt result;
+        if (negA == negB) {
+            result.limbs = addMagnitude(a, b);
+            result.negative = negA;
+        } else if (compareMagnitude(a, b) >= 0) {
+            result.limbs = subtractMagnitude(a, b);
+            result.negative = negA;
+        } else {
+            result.limbs = subtractMagnitude(b, a);
+            result.negative = negB;
+        }
+        result.trim();
+        return result;
+    }
+
+    // floor(|a| / |b|) by shift and subtract
+    static Limbs divideMagnitude(const Limbs& a, const Limbs& b) {
+        BigInt remainder, divisor;
+        divisor.limbs = b;
+        Limbs quotient(a.size(), 0);
+        for (int i = static_cast<int>(64 * a.size()) - 1; i >= 0; --i) {
+            remainder = remainder + remainder;
+            if ((a[i / 64] >> (i % 64)) & 1) remainder = remainder + BigInt(1);
+            if (compareMagnitude(remainder.limbs, divisor.limbs) >= 0) {
+                remainder = remainder - divisor;
+                quotient[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+        return quotient;
+    }
+
+public:
+    BigInt() = default;
+
+    BigInt(int64_t value) : negative(value < 0) {
+        uint64_t magnitude = value < 0 ? uint64_t(0) - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+        if (magnitude) limbs.push_back(magnitude);
+    }
+
+    // a binary string, most significant bit first (the scalar format of BinaryCurve::multiply)
+    static BigInt fromBinary(const std::string& bits) {
+        BigInt result;
+        result.limbs.assign(bits.size() / 64 + 1, 0);
+        for (size_t i = 0; i < bits.size(); ++i) {
+            size_t k = bits.size() - 1 - i;
+            if (bits[i] == '1') result.limbs[k / 64] |= uint64_t(1) << (k % 64);
+        }
+        result.trim();
+        return result;
+    }
+
+    // the magnitude in binary, most significant bit first; "0" for zero
+    std::string toBinary() const {
+        int length = bitLength();
+        if (length == 0) return "0";
+        std::string bits;
+        for (int k = length - 1; k >= 0; --k) bits.push_back(((limbs[k / 64] >> (k % 64)) & 1) ? '1' : '0');
+        return bits;
+    }
+
+    bool isZero() const { return limbs.empty(); }
+    bool isNegative() const { return negative; }
+    bool isOdd() const { return !limbs.empty() && (limbs[0] & 1); }
+
+    int bitLength() const {
+        if (limbs.empty()) return 0;
+        return static_cast<int>(64 * limbs.size()) - __builtin_clzll(limbs.back());
+    }
+
+    // the value mod 2^k in [0, 2^k), k < 64
+    uint64_t lowBits(int k) const {
+        uint64_t mask = (uint64_t(1) << k) - 1;
+        uint64_t low = limbs.empty() ? 0 : limbs[0] & mask;
+        return negative ? (uint64_t(0) - low) & mask : low;
+    }
+
+    // the value if it fits in an int64_t
+    int64_t toInt64() const {
+        int64_t magnitude = limbs.empty() ? 0 : static_cast<int64_t>(limbs[0]);
+        return negative ? -magnitude : magnitude;
+    }
+
+    BigInt operator-() const {
+        BigInt result = *this;
+        if (!result.limbs.empty()) result.negative = !negative;
+        return result;
+    }
+
+    BigInt operator+(const BigInt& other) const {
+        return signedSum(negative, limbs, other.negative, other.limbs);
+    }
+
+    BigInt operator-(const BigInt& other) const {
+        return signedSum(negative, limbs, !other.negative, other.limbs);
+    }
+
+    BigInt operator*(const BigInt& other) const {
+        BigInt result;
+        if (limbs.empty() || other.limbs.empty()) return result;
+        result.limbs.assign(limbs.size() + other.limbs.size(), 0);
+        for (size_t i = 0; i < limbs.size(); ++i) {
+            unsigned __int128 carry = 0;
+            for (size_t j = 0; j < other.limbs.size(); ++j) {
+                carry += static_cast<unsigned __int128>(limbs[i]) * other.limbs[j] + result.limbs[i + j];
+                result.limbs[i + j] = static_cast<uint64_t>(carry);
+                carry >>= 64;
+            }
+            result.limbs[i + other.limbs.size()] = static_cast<uint64_t>(carry);
+        }
+        result.negative = negative != other.negative;
+        result.trim();
+        return result;
+    }
+
+    // exact half of an even value
+    BigInt half() const {
+        BigInt result = *this;
+        for (size_t i = 0; i < result.limbs.size(); ++i) {
+            uint64_t next = i + 1 < result.limbs.size() ? result.limbs[i + 1] : 0;
+            result.limbs[i] = (result.limbs[i] >> 1) | (next << 63);
+        }
+        result.trim();
+        return result;
+    }
+
+    // the integer nearest to a / b for b > 0, halves rounded away from zero
+    static BigInt roundedQuotient(const BigInt& a, const BigInt& b) {
+        BigInt twiceA = a + a;
+        BigInt numerator = signedSum(false, twiceA.limbs, false, b.limbs);
+        BigInt twiceB = b + b;
+        BigInt result;
+        result.limbs = divideMagnitude(numerator.limbs, twiceB.limbs);
+        result.negative = a.negative;
+        result.trim();
+        return result;
+    }
+
+    bool operator==(const BigInt& other) const {
+        return negative == other.negative && limbs == other.limbs;
+    }
+
+    bool operator!=(const BigInt& other) const {
+        return !(*this == other);
+    }
+};
+
+#endif //LW4_BIGINT_H
@@ -0,0 +1,169 @@
+#ifndef LW4_BINARYCURVE_H
+#define LW4_BINARYCURVE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Arena.h"
+#include "ForkJoinGroup.h"
+
+template <typename Field>
+struct BinaryPoint {
+    Field x;
+    Field y;
+    bool infinity;
+
+    BinaryPoint() : x(Field::zero()), y(Field::zero()), infinity(true) {}
+
+    BinaryPoint(const Field& x, const Field& y) : x(x), y(y), infinity(false) {}
+};
+
+// E : y^2 + xy = x^3 + a x^2 + b over any normal-basis field (GF2mElement, GF2mSmall<M>)
+template <typename Field>
+class BinaryCurve {
+private:
+    Field a;
+    Field b;
+
+public:
+    // G, 2^L G, 2^(2L) G, ...: with these precomputed for a fixed G, every L-bit run of a scalar is an
+    // independent multiplication
+    struct SplitBase {
+        int length;
+        std::vector<BinaryPoint<Field>> bases;
+    };
+
+    BinaryCurve(const Field& a, const Field& b) : a(a), b(b) {}
+
+    const Field& getA() const { return a; }
+    const Field& getB() const { return b; }
+
+    // y^2 + xy = x^3 + x^2 + 1 (a = 1) or y^2 + xy = x^3 + 1 (a = 0)
+    static BinaryCurve koblitz(int a) {
+        return BinaryCurve(a ? Field::one() : Field::zero(), Field::one());
+    }
+
+    bool isOnCurve(const BinaryPoint<Field>& P) const {
+        if (P.infinity) return true;
+        Field x2 = P.x.squareONB();
+        Field lhs = P.y.squareONB() + P.x * P.y;
+        Field rhs = x2 * P.x + a * x2 + b;
+        return (lhs + rhs).isZero();
+    }
+
+    // for odd m the half-trace solves z^2 + z = c whenever Tr(c) = 0
+    static Field halfTrace(const Field& c) {
+        Field h = c;
+        for (int i = 2; i < Field::getM(); i += 2) {
+            h = h + c.frobenius(i);
+        }
+        return h;
+    }
+
+    // y = x z with z^2 + z = x + a + b / x^2; returns false if no point with this x exists
+    bool liftX(const Field& x, BinaryPoint<Field>& P) const {
+        if (x.isZero()) return false;
+        Field c = x + a + b * x.squareONB().inverse();
+        if (c.trace()) return false;
+        P = BinaryPoint<Field>(x, x * halfTrace(c));
+        return true;
+    }
+
+    BinaryPoint<Field> negate(const BinaryPoint<Field>& P) const {
+        if (P.infinity) return P;
+        return BinaryPoint<Field>(P.x, P.x + P.y);
+    }
+
+    // (x, y) -> (x^(2^k), y^(2^k)); an endomorphism when a and b lie in GF(2)
+    BinaryPoint<Field> frobenius(const BinaryPoint<Field>& P, int k = 1) const {
+        if (P.infinity) return P;
+        return BinaryPoint<Field>(P.x.frobenius(k), P.y.frobenius(k));
+    }
+
+    BinaryPoint<Field> doublePoint(const BinaryPoint<Field>& P) const {
+        if (P.infinity || P.x.isZero()) return BinaryPoint<Field>();
+        Field lambda = P.x + P.y * P.x.inverse();
+        Field x3 = lambda.squareONB() + lambda + a;
+        Field y3 = P.x.squareONB() + (lambda + Field::one()) * x3;
+        return BinaryPoint<Field>(x3, y3);
+    }
+
+    // P + Q given inv = (x_P + x_Q)^-1, so callers can share one inversion across many additions
+    BinaryPoint<Field> addWithInverse(const BinaryPoint<Field>& P, const BinaryPoint<Field>& Q, const Field& inv) const {
+        Field lambda = (P.y + Q.y) * inv;
+        Field x3 = lambda.squareONB() + lambda + P.x + Q.x + a;
+        Field y3 = lambda * (P.x + x3) + x3 + P.y;
+        return BinaryPoint<Field>(x3, y3);
+    }
+
+    BinaryPoint<Field> add(const BinaryPoint<Field>& P, const BinaryPoint<Field>& Q) const {
+        if (P.infinity) return Q;
+        if (Q.infinity) return P;
+        Field dx = P.x + Q.x;
+        if (dx.isZero()) {
+            if ((P.y + Q.y).isZero()) return doublePoint(P);
+            return BinaryPoint<Field>();
+        }
+        return addWithInverse(P, Q, dx.inverse());
+    }
+
+    // scalar is a binary string, most significant bit first, as in GF2mElement::power
+    BinaryPoint<Field> multiply(const BinaryPoint<Field>& P, const std::string& scalar) const {
+        return Arena::run([&] {
+            BinaryPoint<Field> result;
+            for (char bit : scalar) {
+                result = doublePoint(result);
+                if (bit == '1') {
+                    result = add(result, P);
+                }
+            }
+            return result;
+        });
+    }
+
+    // bases for scalars of up to bits bits cut into parts runs
+    SplitBase splitBase(const BinaryPoint<Field>& G, int parts, int bits) const {
+        SplitBase base{(bits + parts - 1) / parts, {}};
+        BinaryPoint<Field> B = G;
+        for (int j = 0; j < parts; ++j) {
+            base.bases.push_back(B);
+            for (int i = 0; i < base.length; ++i) B = doublePoint(B);
+        }
+        return base;
+    }
+
+    // scalar * G with run j (bits j L .. j L + L - 1, the last run taking any bits above) multiplied by 2^(jL) G on
+    // the threads of the group, then the partial results summed
+    BinaryPoint<Field> multiplyParallel(const SplitBase& base, const std::string& scalar, ForkJoinGroup& group) const {
+        const int parts = static_cast<int>(base.bases.size());
+        const int n = static_cast<int>(scalar.size());
+        std::vector<BinaryPoint<Field>> partial(parts);
+        group.run([&](int index) {
+            for (int j = index; j < parts; j += group.getSize()) {
+                int end = n - j * base.length;
+                if (end <= 0) continue;
+                int start = j == parts - 1 ? 0 : std::max(0, end - base.length);
+                partial[j] = multiply(base.bases[j], scalar.substr(start, end - start));
+            }
+        });
+        BinaryPoint<Field> result;
+        for (const auto& R : partial) result = add(result, R);
+        return result;
+    }
+
+    BinaryPoint<Field> multiply(const BinaryPoint<Field>& P, uint64_t scalar) const {
+        return Arena::run([&] {
+            BinaryPoint<Field> result;
+            for (int i = 63; i >= 0; --i) {
+                result = doublePoint(result);
+                if ((scalar >> i) & 1) {
+                    result = add(result, P);
+                }
+            }
+            return result;
+        });
+    }
+};
+
+#endif //LW4_BINARYCURVE_H
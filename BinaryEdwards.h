@@ -0,0 +1,319 @@
+#ifndef LW4_BINARYEDWARDS_H
+#define LW4_BINARYEDWARDS_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Arena.h"
+#include "BinaryCurve.h"
+#include "GF2mBitsliced.h"
+
+// affine point of a binary Edwards curve; (0, 0) is the neutral element, so there is no point at infinity
+template <typename Field>
+struct EdwardsPoint {
+    Field x;
+    Field y;
+
+    EdwardsPoint() : x(Field::zero()), y(Field::zero()) {}
+
+    EdwardsPoint(const Field& x, const Field& y) : x(x), y(y) {}
+};
+
+// E_B : d1 (x + y) + d2 (x^2 + y^2) = xy + xy (x + y) + x^2 y^2 (Bernstein, Lange, Rezaeian Farashahi).
+// With d1 != 0 and Tr(d2) = 1 the addition law is complete: one formula for every pair of points, doubling
+// and the neutral element included. -(x, y) = (y, x) and (1, 1) has order 2.
+//
+// E_B is birational to the Weierstrass curve v^2 + uv = u^3 + (d1^2 + d2) u^2 + d1^4 (d1^4 + d1^2 + d2^2),
+// which in turn is isomorphic to the curve y^2 + xy = x^3 + a x^2 + b it was built from by (u, v) = (x, y + s x).
+template <typename Field>
+class BinaryEdwardsCurve {
+public:
+    // w = x + y is shared by P and -P. Ladders run on z = d1 (w + 1) / w, where doubling is
+    // z -> z^2 + sqrt(b) / z^2 and P + Q follows from P - Q as z(P + Q) = z(P - Q) + t + t^2 with
+    // t = z(P) / (z(P) + z(Q)); LadderPoint holds z = X / Z, the neutral element (and (1, 1)) is (1 : 0).
+    struct LadderPoint {
+        Field X;
+        Field Z;
+    };
+
+private:
+    Field d1;
+    Field d2;
+    Field a; // the Weierstrass partner y^2 + xy = x^3 + a x^2 + b
+    Field b;
+    Field s; // s^2 + s = a + d1^2 + d2
+    Field k; // d1^2 + d1 + d2
+    Field c; // (d1^2 + d1) k
+    Field doublingConstant; // b^(1/4)
+
+    BinaryEdwardsCurve(const Field& d1, const Field& d2, const Field& a, const Field& b, const Field& s)
+        : d1(d1), d2(d2), a(a), b(b), s(s), k(d1.squareONB() + d1 + d2), c((d1.squareONB() + d1) * k),
+          doublingConstant(b.frobenius(-2)) {}
+
+    // Montgomery's trick: one inversion for the whole vector; zero entries stay zero
+    static void invertAll(std::vector<Field>& values) {
+        ArenaVector<Field> prefix;
+        prefix.reserve(values.size());
+        Field running = Field::one();
+        for (const Field& v : values) {
+            prefix.push_back(running);
+            if (!v.isZero()) running = running * v;
+        }
+        Field inv = running.inverse();
+        for (size_t i = values.size(); i-- > 0;) {
+            if (values[i].isZero()) continue;
+            Field next = inv * values[i];
+            values[i] = inv * prefix[i];
+            inv = next;
+        }
+    }
+
+public:
+    // a = d1^2 + d2, b = d1^4 (d1^4 + d1^2 + d2^2)
+    BinaryEdwardsCurve(const Field& d1, const Field& d2)
+        : BinaryEdwardsCurve(d1, d2, d1.squareONB() + d2,
+                             d1.frobenius(2) * (d1.frobenius(2) + d1.squareONB() + d2.squareONB()), Field::zero()) {}
+
+    // an Edwards model of y^2 + xy = x^3 + a x^2 + b. d1 must give Tr(d1) != Tr(a) (then Tr(d2) = 1) and
+    // Tr(sqrt(b) / d1^2) = 1 (then a and d1^2 + d2 differ by some s^2 + s); the candidates are
+    // seed, seed^2 + 1, ... as in d1 -> d1 * seed + 1. For GF2mElement, Nist233::b233() and Nist233::k233() give
+    // B-233 and K-233 with their base points in ONB coordinates. Returns false if no candidate qualifies.
+    static bool fromWeierstrassCurve(const BinaryCurve<Field>& curve, const Field& seed, BinaryEdwardsCurve& edwards,
+                                     int attempts = 256) {
+        const Field& a = curve.getA();
+        const Field& b = curve.getB();
+        if (b.isZero()) return false;
+        Field root = b.sqrtONB();
+        Field d1 = seed;
+        for (int i = 0; i < attempts; ++i, d1 = d1 * seed + Field::one()) {
+            if (d1.isZero() || d1.trace() == a.trace()) continue;
+            Field t = root * d1.squareONB().inverse();
+            if (!t.trace()) continue;
+            Field d2 = t + d1 + d1.squareONB(); // d1^2 + a' for a' = sqrt(b) / d1^2 + d1
+            Field s = BinaryCurve<Field>::halfTrace(a + t + d1);
+            edwards = BinaryEdwardsCurve(d1, d2, a, b, s);
+            return true;
+        }
+        return false;
+    }
+
+    const Field& getD1() const { return d1; }
+    const Field& getD2() const { return d2; }
+
+    BinaryCurve<Field> weierstrass() const {
+        return BinaryCurve<Field>(a, b);
+    }
+
+    bool isOnCurve(const EdwardsPoint<Field>& P) const {
+        Field xy = P.x * P.y;
+        Field sum = P.x + P.y;
+        Field lhs = d1 * sum + d2 * sum.squareONB();
+        Field rhs = xy + xy * sum + xy.squareONB();
+        return (lhs + rhs).isZero();
+    }
+
+    // (u, v) -> (u, v + s u) onto the d1, d2 model, then w = d1 u / (u^2 + d1 u + d1^2 k) and
+    // x = d1 (u + k) / (u + v + c), or y = d1 (u + k) / (v + c) on the line where that denominator vanishes
+    EdwardsPoint<Field> fromWeierstrass(const BinaryPoint<Field>& P) const {
+        if (P.infinity) return EdwardsPoint<Field>();
+        const Field& u = P.x;
+        Field v = P.y + s * u;
+        Field w = d1 * u * (u.squareONB() + d1 * u + d1.squareONB() * k).inverse();
+        Field numerator = d1 * (u + k);
+        Field den = u + v + c;
+        if (!den.isZero()) {
+            Field x = numerator * den.inverse();
+            return EdwardsPoint<Field>(x, x + w);
+        }
+        Field y = numerator * (v + c).inverse();
+        return EdwardsPoint<Field>(y + w, y);
+    }
+
+    // u = d1 k (x + y) / (xy + d1 (x + y)), v = d1 k (x / (xy + d1 (x + y)) + d1 + 1); (0, 0) is the point at infinity
+    BinaryPoint<Field> toWeierstrass(const EdwardsPoint<Field>& P) const {
+        Field sum = P.x + P.y;
+        Field den = P.x * P.y + d1 * sum;
+        if (den.isZero()) return BinaryPoint<Field>();
+        Field inv = den.inverse();
+        Field dk = d1 * k;
+        Field u = dk * sum * inv;
+        Field v = dk * (P.x * inv + d1 + Field::one());
+        return BinaryPoint<Field>(u, v + s * u);
+    }
+
+    EdwardsPoint<Field> negate(const EdwardsPoint<Field>& P) const {
+        return EdwardsPoint<Field>(P.y, P.x);
+    }
+
+    // the complete law; both denominators are nonzero for every input, and one inversion serves both
+    EdwardsPoint<Field> add(const EdwardsPoint<Field>& P, const EdwardsPoint<Field>& Q) const {
+        Field x1s = P.x + P.x.squareONB();
+        Field y1s = P.y + P.y.squareONB();
+        Field w2 = Q.x + Q.y;
+        Field shared = d2 * (P.x + P.y) * w2;
+        Field xNum = d1 * (P.x + Q.x) + shared + x1s * (Q.x * (P.y + Q.y + Field::one()) + P.y * Q.y);
+        Field yNum = d1 * (P.y + Q.y) + shared + y1s * (Q.y * (P.x + Q.x + Field::one()) + P.x * Q.x);
+        Field xDen = d1 + x1s * w2;
+        Field yDen = d1 + y1s * w2;
+        Field inv = (xDen * yDen).inverse();
+        return EdwardsPoint<Field>(xNum * yDen * inv, yNum * xDen * inv);
+    }
+
+    EdwardsPoint<Field> doublePoint(const EdwardsPoint<Field>& P) const {
+        return add(P, P);
+    }
+
+    // scalar is a binary string, most significant bit first, as in BinaryCurve::multiply
+    EdwardsPoint<Field> multiply(const EdwardsPoint<Field>& P, const std::string& scalar) const {
+        return Arena::run([&] {
+            EdwardsPoint<Field> result;
+            for (char bit : scalar) {
+                result = doublePoint(result);
+                if (bit == '1') {
+                    result = add(result, P);
+                }
+            }
+            return result;
+        });
+    }
+
+    EdwardsPoint<Field> multiply(const EdwardsPoint<Field>& P, uint64_t scalar) const {
+        return Arena::run([&] {
+            EdwardsPoint<Field> result;
+            for (int i = 63; i >= 0; --i) {
+                result = doublePoint(result);
+                if ((scalar >> i) & 1) {
+                    result = add(result, P);
+                }
+            }
+            return result;
+        });
+    }
+
+    LadderPoint toLadder(const Field& w) const {
+        return LadderPoint{d1 * (w + Field::one()), w};
+    }
+
+    // w = d1 / (z + d1); z = d1 would need w = infinity, so the denominator never vanishes
+    Field fromLadder(const LadderPoint& P) const {
+        if (P.Z.isZero()) return Field::zero();
+        Field dz = d1 * P.Z;
+        return dz * (P.X + dz).inverse();
+    }
+
+    // (X : Z) -> ((X^2 + b^(1/4) Z^2)^2 : X^2 Z^2)
+    LadderPoint ladderDouble(const LadderPoint& P) const {
+        Field X2 = P.X.squareONB();
+        Field Z2 = P.Z.squareONB();
+        return LadderPoint{(X2 + doublingConstant * Z2).squareONB(), X2 * Z2};
+    }
+
+    // P + Q from z of P - Q (affine): Z = (X_P Z_Q + X_Q Z_P)^2, X = z_D Z + X_P Z_Q X_Q Z_P. Also right when
+    // P is the neutral element, since then Q = P - Q.
+    LadderPoint differentialAdd(const LadderPoint& P, const LadderPoint& Q, const Field& difference) const {
+        Field left = P.X * Q.Z;
+        Field right = Q.X * P.Z;
+        Field Z = (left + right).squareONB();
+        return LadderPoint{difference * Z + left * right, Z};
+    }
+
+    // w(scalar * P) from w(P), Montgomery ladder with the invariant R1 - R0 = P
+    Field ladder(const Field& w, const std::string& scalar) const {
+        return Arena::run([&] {
+            if (w.isZero()) return w;
+            Field difference = d1 + d1 * w.inverse();
+            LadderPoint R0{Field::one(), Field::zero()};
+            LadderPoint R1{difference, Field::one()};
+            for (char bit : scalar) {
+                if (bit == '1') {
+                    R0 = differentialAdd(R0, R1, difference);
+                    R1 = ladderDouble(R1);
+                } else {
+                    R1 = differentialAdd(R0, R1, difference);
+                    R0 = ladderDouble(R0);
+                }
+            }
+            return fromLadder(R0);
+        });
+    }
+
+    // w(scalars[i] * P_i) for up to 64 inputs in one bitsliced ladder (GF2mElement only). Every lane runs the
+    // same sequence of operations; the scalar bits only choose the swap masks. Shorter scalars are padded with
+    // leading zeros, which keep R0 at the neutral element.
+    std::vector<Field> batchLadder(const std::vector<Field>& ws, const std::vector<std::string>& scalars) const {
+        return Arena::run([&] {
+            const size_t count = std::min(ws.size(), scalars.size());
+            if (count > GF2mBitsliced::LANES) {
+                std::vector<Field> result;
+                for (size_t from = 0; from < count; from += GF2mBitsliced::LANES) {
+                    size_t to = std::min(count, from + GF2mBitsliced::LANES);
+                    std::vector<Field> part = batchLadder(std::vector<Field>(ws.begin() + from, ws.begin() + to),
+                                                          std::vector<std::string>(scalars.begin() + from, scalars.begin() + to));
+                    result.insert(result.end(), part.begin(), part.end());
+                }
+                return result;
+            }
+
+            // affine z of the inputs; lanes with w = 0 are kept as zero and masked out at the end
+            std::vector<Field> inverses(ws.begin(), ws.begin() + count);
+            invertAll(inverses);
+            std::array<GF2mBitsliced::Words, GF2mBitsliced::LANES> lanes{};
+            uint64_t neutral = 0;
+            size_t bits = 0;
+            for (size_t t = 0; t < count; ++t) {
+                if (ws[t].isZero()) neutral |= uint64_t(1) << t;
+                else lanes[t] = (d1 + d1 * inverses[t]).toWords();
+                bits = std::max(bits, scalars[t].size());
+            }
+
+            const GF2mBitsliced difference = GF2mBitsliced::pack(lanes);
+            const GF2mBitsliced constant = GF2mBitsliced::broadcast(doublingConstant.toWords());
+            GF2mBitsliced X0 = GF2mBitsliced::broadcast(Field::one().toWords()), Z0;
+            GF2mBitsliced X1 = difference, Z1 = GF2mBitsliced::broadcast(Field::one().toWords());
+            uint64_t swapped = 0;
+            for (size_t i = 0; i < bits; ++i) {
+                uint64_t mask = 0;
+                for (size_t t = 0; t < count; ++t) {
+                    const std::string& scalar = scalars[t];
+                    size_t pad = bits - scalar.size();
+                    if (i >= pad && scalar[i - pad] == '1') mask |= uint64_t(1) << t;
+                }
+                // bit 1 lanes run the bit 0 step on (R1, R0)
+                GF2mBitsliced::conditionalSwap(mask ^ swapped, X0, X1);
+                GF2mBitsliced::conditionalSwap(mask ^ swapped, Z0, Z1);
+                swapped = mask;
+
+                GF2mBitsliced left = X0 * Z1;
+                GF2mBitsliced right = X1 * Z0;
+                Z1 = (left + right).square();
+                X1 = difference * Z1 + left * right;
+                GF2mBitsliced X2 = X0.square();
+                GF2mBitsliced Z2 = Z0.square();
+                X0 = (X2 + constant * Z2).square();
+                Z0 = X2 * Z2;
+            }
+            GF2mBitsliced::conditionalSwap(swapped, X0, X1);
+            GF2mBitsliced::conditionalSwap(swapped, Z0, Z1);
+
+            // w = d1 Z / (X + d1 Z), batched the same way; Z = 0 lanes give w = 0
+            uint64_t atInfinity = Z0.zeroLanes() | neutral;
+            GF2mBitsliced dz = GF2mBitsliced::broadcast(d1.toWords()) * Z0;
+            auto numerators = dz.unpack();
+            auto denominators = (X0 + dz).unpack();
+            std::vector<Field> result;
+            std::vector<Field> dens;
+            for (size_t t = 0; t < count; ++t) {
+                bool zero = (atInfinity >> t) & 1;
+                result.push_back(zero ? Field::zero() : Field::fromWords(numerators[t]));
+                dens.push_back(zero ? Field::zero() : Field::fromWords(denominators[t]));
+            }
+            invertAll(dens);
+            for (size_t t = 0; t < count; ++t) result[t] = result[t] * dens[t];
+            return result;
+        });
+    }
+};
+
+#endif //LW4_BINARYEDWARDS_H
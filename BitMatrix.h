@@ -0,0 +1,292 @@
+#ifndef LW4_BITMATRIX_H
+#define LW4_BITMATRIX_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LW4_HAVE_X86 1
+#endif
+
+// Dense GF(2) matrix with rows packed into 64-bit words (bit c of row r is column c). Besides the row form it
+// keeps the 8x8 blocks in the layout of the Galois-field affine instruction (GF2P8AFFINEQB): block (I, J), byte
+// 7 - i, bit k holds entry (8I + i, 8J + k). One instruction then multiplies a block by eight byte-vectors, so
+// eight vectors are converted at once. Hosts without GFNI, or with LW4_NO_GFNI set, use the scalar kernels.
+class BitMatrix {
+public:
+    enum Kernel { SCALAR, GFNI };
+
+private:
+    int rows;
+    int cols;
+    int rowWords;
+    std::vector<uint64_t> data;
+
+    int rowBlocks;
+    int colBlocks; // rounded up to even, two blocks per 128-bit instruction
+    std::vector<uint64_t> blocks;
+
+    static Kernel detect() {
+        if (std::getenv("LW4_NO_GFNI")) return SCALAR;
+#ifdef LW4_HAVE_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("gfni")) return GFNI;
+#endif
+        return SCALAR;
+    }
+
+    static uint64_t reverse64(uint64_t x) {
+        x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+        x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+        x = ((x >> 4) & 0x0f0f0f0f0f0f0f0fULL) | ((x & 0x0f0f0f0f0f0f0f0fULL) << 4);
+        return __builtin_bswap64(x);
+    }
+
+    // 8x8 transpose of a block stored one row per byte (byte r, bit c -> byte c, bit r)
+    static uint64_t transpose8(uint64_t x) {
+        uint64_t t;
+        t = (x ^ (x >> 7)) & 0x00aa00aa00aa00aaULL;
+        x ^= t ^ (t << 7);
+        t = (x ^ (x >> 14)) & 0x0000cccc0000ccccULL;
+        x ^= t ^ (t << 14);
+        t = (x ^ (x >> 28)) & 0x00000000f0f0f0f0ULL;
+        x ^= t ^ (t << 28);
+        return x;
+    }
+
+    static uint8_t byteOf(const std::vector<uint64_t>& bits, int index) {
+        return static_cast<uint8_t>(bits[index / 8] >> (8 * (index % 8)));
+    }
+
+    void buildBlocks() {
+        rowBlocks = (rows + 7) / 8;
+        colBlocks = ((cols + 7) / 8 + 1) & ~1;
+        blocks.assign(static_cast<size_t>(rowBlocks) * colBlocks, 0);
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                if (!get(r, c)) continue;
+                blocks[(r / 8) * colBlocks + c / 8] |= uint64_t(1) << (8 * (7 - r % 8) + c % 8);
+            }
+        }
+    }
+
+#ifdef LW4_HAVE_X86
+    // X[J] byte t = byte J of vector t, Y[I] byte t = byte I of the product with vector t
+    __attribute__((target("gfni,sse2")))
+    void applyBlocksGfni(const uint64_t* X, uint64_t* Y) const {
+        for (int I = 0; I < rowBlocks; ++I) {
+            const uint64_t* row = blocks.data() + static_cast<size_t>(I) * colBlocks;
+            __m128i acc = _mm_setzero_si128();
+            for (int J = 0; J < colBlocks; J += 2) {
+                __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(X + J));
+                __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + J));
+                acc = _mm_xor_si128(acc, _mm_gf2p8affine_epi64_epi8(x, a, 0));
+            }
+            uint64_t lanes[2];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc);
+            Y[I] = lanes[0] ^ lanes[1];
+        }
+    }
+
+    // byte t of the result is column t of the block: the affine instruction with unit vectors as data
+    __attribute__((target("gfni,sse2")))
+    static void transposeBlocksGfni(const uint64_t* in, uint64_t* out, size_t count) {
+        const __m128i units = _mm_set1_epi64x(static_cast<long long>(0x8040201008040201ULL));
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2) {
+            // the instruction reads matrix rows from byte 7 down, so the rows are byte-reversed first
+            __m128i rowsReversed = _mm_set_epi64x(static_cast<long long>(__builtin_bswap64(in[i + 1])),
+                                                  static_cast<long long>(__builtin_bswap64(in[i])));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_gf2p8affine_epi64_epi8(units, rowsReversed, 0));
+        }
+        for (; i < count; ++i) out[i] = transpose8(in[i]);
+    }
+
+    // reversed bit order inside every byte: result bit i reads matrix byte 7 - i, which selects bit 7 - i
+    __attribute__((target("gfni,sse2")))
+    static void reverseBytesGfni(uint64_t* words, size_t count) {
+        const __m128i flip = _mm_set1_epi64x(static_cast<long long>(0x8040201008040201ULL));
+        size_t i = 0;
+        for (; i + 2 <= count; i += 2) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(words + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(words + i), _mm_gf2p8affine_epi64_epi8(x, flip, 0));
+        }
+        for (; i < count; ++i) words[i] = __builtin_bswap64(reverse64(words[i]));
+    }
+#endif
+
+public:
+    BitMatrix(int rows, int cols)
+        : rows(rows), cols(cols), rowWords((cols + 63) / 64), data(static_cast<size_t>(rows) * rowWords, 0) {
+        buildBlocks();
+    }
+
+    static BitMatrix identity(int n) {
+        BitMatrix result(n, n);
+        for (int i = 0; i < n; ++i) result.data[static_cast<size_t>(i) * result.rowWords + i / 64] |= uint64_t(1) << (i % 64);
+        result.buildBlocks();
+        return result;
+    }
+
+    // column c is columns[c], given as packed bits
+    static BitMatrix fromColumns(int rows, const std::vector<std::vector<uint64_t>>& columns) {
+        BitMatrix result(rows, static_cast<int>(columns.size()));
+        for (int c = 0; c < result.cols; ++c) {
+            for (int r = 0; r < rows; ++r) {
+                if ((columns[c][r / 64] >> (r % 64)) & 1) {
+                    result.data[static_cast<size_t>(r) * result.rowWords + c / 64] |= uint64_t(1) << (c % 64);
+                }
+            }
+        }
+        result.buildBlocks();
+        return result;
+    }
+
+    static Kernel kernel() {
+        static const Kernel selected = detect();
+        return selected;
+    }
+
+    static const char* kernelName(Kernel k) {
+        return k == GFNI ? "gfni" : "scalar";
+    }
+
+    int getRows() const { return rows; }
+    int getCols() const { return cols; }
+
+    bool get(int r, int c) const {
+        return (data[static_cast<size_t>(r) * rowWords + c / 64] >> (c % 64)) & 1;
+    }
+
+    // Gauss-Jordan on [M | I]; false if M is singular
+    bool invert(BitMatrix& result) const {
+        if (rows != cols) return false;
+        std::vector<uint64_t> left = data;
+        BitMatrix right = identity(rows);
+        for (int col = 0; col < cols; ++col) {
+            int w = col / 64;
+            uint64_t b = uint64_t(1) << (col % 64);
+            int pivot = col;
+            while (pivot < rows && !(left[static_cast<size_t>(pivot) * rowWords + w] & b)) ++pivot;
+            if (pivot == rows) return false;
+            for (int v = 0; v < rowWords; ++v) {
+                std::swap(left[static_cast<size_t>(pivot) * rowWords + v], left[static_cast<size_t>(col) * rowWords + v]);
+                std::swap(right.data[static_cast<size_t>(pivot) * rowWords + v], right.data[static_cast<size_t>(col) * rowWords + v]);
+            }
+            for (int r = 0; r < rows; ++r) {
+                if (r == col || !(left[static_cast<size_t>(r) * rowWords + w] & b)) continue;
+                for (int v = 0; v < rowWords; ++v) {
+                    left[static_cast<size_t>(r) * rowWords + v] ^= left[static_cast<size_t>(col) * rowWords + v];
+                    right.data[static_cast<size_t>(r) * rowWords + v] ^= right.data[static_cast<size_t>(col) * rowWords + v];
+                }
+            }
+        }
+        right.buildBlocks();
+        result = std::move(right);
+        return true;
+    }
+
+    // M x for one packed vector
+    std::vector<uint64_t> apply(const std::vector<uint64_t>& x) const {
+        std::vector<uint64_t> y((rows + 63) / 64, 0);
+        for (int r = 0; r < rows; ++r) {
+            const uint64_t* row = data.data() + static_cast<size_t>(r) * rowWords;
+            uint64_t parity = 0;
+            for (int v = 0; v < rowWords; ++v) parity ^= row[v] & x[v];
+            if (__builtin_parityll(parity)) y[r / 64] |= uint64_t(1) << (r % 64);
+        }
+        return y;
+    }
+
+    // M x for up to eight vectors: the vectors are interleaved byte-wise, so byte t of qword J is byte J of
+    // vector t, and each 8x8 block multiplies all eight at once
+    std::vector<std::vector<uint64_t>> applyBatch(const std::vector<std::vector<uint64_t>>& xs, Kernel k = kernel()) const {
+        std::vector<std::vector<uint64_t>> ys;
+#ifdef LW4_HAVE_X86
+        if (k == GFNI) {
+            for (size_t base = 0; base < xs.size(); base += 8) {
+                size_t count = std::min<size_t>(8, xs.size() - base);
+                std::vector<uint64_t> X(colBlocks, 0), Y(rowBlocks, 0);
+                for (size_t t = 0; t < count; ++t) {
+                    for (int J = 0; J < (cols + 7) / 8; ++J) X[J] |= uint64_t(byteOf(xs[base + t], J)) << (8 * t);
+                }
+                applyBlocksGfni(X.data(), Y.data());
+                for (size_t t = 0; t < count; ++t) {
+                    std::vector<uint64_t> y((rows + 63) / 64, 0);
+                    for (int I = 0; I < rowBlocks; ++I) y[I / 8] |= ((Y[I] >> (8 * t)) & 0xff) << (8 * (I % 8));
+                    ys.push_back(std::move(y));
+                }
+            }
+            return ys;
+        }
+#endif
+        (void) k;
+        for (const auto& x : xs) ys.push_back(apply(x));
+        return ys;
+    }
+
+    // out = the first `bits` bits of in in reverse order (the word form of GF2mElement::transposeToVector)
+    static std::vector<uint64_t> reverseBits(const std::vector<uint64_t>& in, int bits, Kernel k = kernel()) {
+        size_t words = (bits + 63) / 64;
+        std::vector<uint64_t> reversed(words, 0);
+        // whole-word reversal puts bit i at 64 * words - 1 - i; the bytes are reversed by the word order
+        // and bswap, the bits inside each byte by the kernel
+        for (size_t w = 0; w < words; ++w) reversed[words - 1 - w] = __builtin_bswap64(w < in.size() ? in[w] : 0);
+#ifdef LW4_HAVE_X86
+        if (k == GFNI) {
+            reverseBytesGfni(reversed.data(), words);
+        } else
+#endif
+        {
+            for (auto& word : reversed) word = __builtin_bswap64(reverse64(word));
+        }
+        (void) k;
+        int shift = static_cast<int>(64 * words) - bits;
+        if (shift) {
+            for (size_t w = 0; w < words; ++w) {
+                reversed[w] = (reversed[w] >> shift) | (w + 1 < words ? reversed[w + 1] << (64 - shift) : 0);
+            }
+        }
+        return reversed;
+    }
+
+    // bitslice transposition of 8x8 blocks, one row per byte
+    static void transposeBlocks(const uint64_t* in, uint64_t* out, size_t count, Kernel k = kernel()) {
+#ifdef LW4_HAVE_X86
+        if (k == GFNI) {
+            transposeBlocksGfni(in, out, count);
+            return;
+        }
+#endif
+        (void) k;
+        for (size_t i = 0; i < count; ++i) out[i] = transpose8(in[i]);
+    }
+
+    // 64 x 64 transpose (out[i] bit j = in[j] bit i), e.g. 64 elements to 64 bit-slices: the 8x8 blocks
+    // are gathered a byte at a time, transposed, and stored at the mirrored block position
+    static void transpose64(const uint64_t* in, uint64_t* out, Kernel k = kernel()) {
+        std::array<uint64_t, 64> gathered{}, transposed{};
+        for (int I = 0; I < 8; ++I) {
+            for (int J = 0; J < 8; ++J) {
+                uint64_t block = 0;
+                for (int r = 0; r < 8; ++r) block |= ((in[8 * I + r] >> (8 * J)) & 0xff) << (8 * r);
+                gathered[8 * I + J] = block;
+            }
+        }
+        transposeBlocks(gathered.data(), transposed.data(), 64, k);
+        for (int i = 0; i < 64; ++i) out[i] = 0;
+        for (int I = 0; I < 8; ++I) {
+            for (int J = 0; J < 8; ++J) {
+                uint64_t block = transposed[8 * I + J];
+                for (int r = 0; r < 8; ++r) out[8 * J + r] |= ((block >> (8 * r)) & 0xff) << (8 * I);
+            }
+        }
+    }
+};
+
+#endif //LW4_BITMATRIX_H
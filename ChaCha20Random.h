@@ -0,0 +1,241 @@
+#ifndef LW4_CHACHA20RANDOM_H
+#define LW4_CHACHA20RANDOM_H
+
+#include <array>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "GF2mElement.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#ifdef __linux__
+#include <sys/random.h>
+#endif
+
+// Bulk uniform elements from a ChaCha20 keystream (20 rounds, 64-bit block counter and 64-bit stream id as in the
+// original ChaCha). The default generator takes its 256-bit key from getrandom; the seeded one derives the key
+// from a 64-bit seed, so benchmarks and tests can repeat a run, with the stream id telling threads apart. With
+// SSE2, four blocks are computed at once, one per 32-bit lane. local() is a per-thread generator keyed from
+// getrandom on first use. Elements are four keystream words with the bits above coefficient 232 cleared, in the
+// GF2mElement::toWords order.
+class ChaCha20Random {
+public:
+    using Words = std::array<uint64_t, 4>;
+    using Key = std::array<uint32_t, 8>;
+
+private:
+    static const int m = 233;
+    static constexpr uint64_t topMask = (uint64_t(1) << (m - 192)) - 1;
+    static const int LANES = 4;
+    static const int BLOCK_WORDS = 8; // 64-bit words per block
+
+    std::array<uint32_t, 16> state;
+    std::array<uint64_t, LANES * BLOCK_WORDS> buffer;
+    size_t position = LANES * BLOCK_WORDS;
+
+    static uint32_t rotl(uint32_t x, int n) {
+        return (x << n) | (x >> (32 - n));
+    }
+
+    static void quarterRound(uint32_t& a, uint32_t& b, uint32_t& c, uint32_t& d) {
+        a += b; d = rotl(d ^ a, 16);
+        c += d; b = rotl(b ^ c, 12);
+        a += b; d = rotl(d ^ a, 8);
+        c += d; b = rotl(b ^ c, 7);
+    }
+
+    static void scalarBlock(const std::array<uint32_t, 16>& input, uint64_t* out) {
+        std::array<uint32_t, 16> x = input;
+        for (int round = 0; round < 10; ++round) {
+            quarterRound(x[0], x[4], x[8], x[12]);
+            quarterRound(x[1], x[5], x[9], x[13]);
+            quarterRound(x[2], x[6], x[10], x[14]);
+            quarterRound(x[3], x[7], x[11], x[15]);
+            quarterRound(x[0], x[5], x[10], x[15]);
+            quarterRound(x[1], x[6], x[11], x[12]);
+            quarterRound(x[2], x[7], x[8], x[13]);
+            quarterRound(x[3], x[4], x[9], x[14]);
+        }
+        for (int i = 0; i < BLOCK_WORDS; ++i) {
+            out[i] = (x[2 * i] + input[2 * i]) | uint64_t(x[2 * i + 1] + input[2 * i + 1]) << 32;
+        }
+    }
+
+#if defined(__SSE2__)
+    template <int n>
+    static __m128i rotl(__m128i x) {
+        return _mm_or_si128(_mm_slli_epi32(x, n), _mm_srli_epi32(x, 32 - n));
+    }
+
+    static void quarterRound(__m128i& a, __m128i& b, __m128i& c, __m128i& d) {
+        a = _mm_add_epi32(a, b); d = rotl<16>(_mm_xor_si128(d, a));
+        c = _mm_add_epi32(c, d); b = rotl<12>(_mm_xor_si128(b, c));
+        a = _mm_add_epi32(a, b); d = rotl<8>(_mm_xor_si128(d, a));
+        c = _mm_add_epi32(c, d); b = rotl<7>(_mm_xor_si128(b, c));
+    }
+
+    // blocks counter .. counter + 3, word i of every block in lane j of x[i]
+    static void vectorBlocks(const std::array<uint32_t, 16>& input, uint64_t* out) {
+        uint64_t counter = input[12] | uint64_t(input[13]) << 32;
+        __m128i start[16], x[16];
+        for (int i = 0; i < 16; ++i) start[i] = _mm_set1_epi32(static_cast<int>(input[i]));
+        std::array<uint32_t, LANES> low, high;
+        for (int j = 0; j < LANES; ++j) {
+            low[j] = static_cast<uint32_t>(counter + j);
+            high[j] = static_cast<uint32_t>((counter + j) >> 32);
+        }
+        start[12] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(low.data()));
+        start[13] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(high.data()));
+        for (int i = 0; i < 16; ++i) x[i] = start[i];
+        for (int round = 0; round < 10; ++round) {
+            quarterRound(x[0], x[4], x[8], x[12]);
+            quarterRound(x[1], x[5], x[9], x[13]);
+            quarterRound(x[2], x[6], x[10], x[14]);
+            quarterRound(x[3], x[7], x[11], x[15]);
+            quarterRound(x[0], x[5], x[10], x[15]);
+            quarterRound(x[1], x[6], x[11], x[12]);
+            quarterRound(x[2], x[7], x[8], x[13]);
+            quarterRound(x[3], x[4], x[9], x[14]);
+        }
+        alignas(16) uint32_t words[16][LANES];
+        for (int i = 0; i < 16; ++i) {
+            _mm_store_si128(reinterpret_cast<__m128i*>(words[i]), _mm_add_epi32(x[i], start[i]));
+        }
+        for (int j = 0; j < LANES; ++j) {
+            for (int i = 0; i < BLOCK_WORDS; ++i) {
+                out[j * BLOCK_WORDS + i] = words[2 * i][j] | uint64_t(words[2 * i + 1][j]) << 32;
+            }
+        }
+    }
+#endif
+
+    // the next LANES blocks into out
+    void blocks(uint64_t* out) {
+#if defined(__SSE2__)
+        vectorBlocks(state, out);
+#else
+        std::array<uint32_t, 16> input = state;
+        for (int j = 0; j < LANES; ++j) {
+            uint64_t counter = (state[12] | uint64_t(state[13]) << 32) + j;
+            input[12] = static_cast<uint32_t>(counter);
+            input[13] = static_cast<uint32_t>(counter >> 32);
+            scalarBlock(input, out + j * BLOCK_WORDS);
+        }
+#endif
+        uint64_t counter = (state[12] | uint64_t(state[13]) << 32) + LANES;
+        state[12] = static_cast<uint32_t>(counter);
+        state[13] = static_cast<uint32_t>(counter >> 32);
+    }
+
+    void init(const Key& key, uint64_t stream, uint64_t counter) {
+        // "expand 32-byte k"
+        state = {0x61707865, 0x3320646e, 0x79622d32, 0x6b206574};
+        for (int i = 0; i < 8; ++i) state[4 + i] = key[i];
+        state[12] = static_cast<uint32_t>(counter);
+        state[13] = static_cast<uint32_t>(counter >> 32);
+        state[14] = static_cast<uint32_t>(stream);
+        state[15] = static_cast<uint32_t>(stream >> 32);
+        position = buffer.size();
+    }
+
+public:
+    // a key from getrandom, or std::random_device where that is missing; false if the system source failed
+    static bool systemKey(Key& key) {
+#ifdef __linux__
+        uint8_t* bytes = reinterpret_cast<uint8_t*>(key.data());
+        size_t done = 0;
+        while (done < sizeof(key)) {
+            ssize_t n = getrandom(bytes + done, sizeof(key) - done, 0);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            done += static_cast<size_t>(n);
+        }
+        return true;
+#else
+        std::random_device device;
+        for (auto& word : key) word = device();
+        return true;
+#endif
+    }
+
+    // keyed from the system source (std::random_device if getrandom fails)
+    ChaCha20Random() {
+        Key key;
+        if (!systemKey(key)) {
+            std::random_device device;
+            for (auto& word : key) word = device();
+        }
+        init(key, 0, 0);
+    }
+
+    ChaCha20Random(const Key& key, uint64_t stream, uint64_t counter = 0) {
+        init(key, stream, counter);
+    }
+
+    // reproducible: the key is the seed spread by splitmix64, stream picks one of 2^64 independent sequences
+    explicit ChaCha20Random(uint64_t seed, uint64_t stream = 0) {
+        Key key;
+        for (int i = 0; i < 4; ++i) {
+            uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            z ^= z >> 31;
+            key[2 * i] = static_cast<uint32_t>(z);
+            key[2 * i + 1] = static_cast<uint32_t>(z >> 32);
+        }
+        init(key, stream, 0);
+    }
+
+    // this thread's generator, keyed from the system source
+    static ChaCha20Random& local() {
+        thread_local ChaCha20Random generator;
+        return generator;
+    }
+
+    uint64_t next() {
+        if (position == buffer.size()) {
+            blocks(buffer.data());
+            position = 0;
+        }
+        return buffer[position++];
+    }
+
+    // n keystream words, whole block groups straight into out
+    void fill(uint64_t* out, size_t n) {
+        while (n && position < buffer.size()) {
+            *out++ = buffer[position++];
+            --n;
+        }
+        for (; n >= buffer.size(); n -= buffer.size(), out += buffer.size()) blocks(out);
+        for (; n; --n) *out++ = next();
+    }
+
+    Words element() {
+        Words w;
+        fill(w.data(), 4);
+        w[3] &= topMask;
+        return w;
+    }
+
+    void fillElements(Words* out, size_t n) {
+        fill(reinterpret_cast<uint64_t*>(out), 4 * n);
+        for (size_t i = 0; i < n; ++i) out[i][3] &= topMask;
+    }
+
+    std::vector<Words> elements(size_t n) {
+        std::vector<Words> result(n);
+        fillElements(result.data(), n);
+        return result;
+    }
+
+    GF2mElement gf2mElement() {
+        return GF2mElement::fromWords(element());
+    }
+};
+
+#endif //LW4_CHACHA20RANDOM_H
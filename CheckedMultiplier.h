@@ -0,0 +1,91 @@
+#ifndef LW4_CHECKEDMULTIPLIER_H
+#define LW4_CHECKEDMULTIPLIER_H
+
+#include <array>
+#include <cstdint>
+#include "GF2mPalindromic.h"
+
+// Concurrent error detection for the palindromic multiplier, against faults induced while a product is computed.
+// A type II optimal normal basis is self-dual, Tr(b_i b_j) = [i = j], and Tr(1) = 1 with 1 the all-ones element,
+// so Tr(c) is the parity of c and Tr(a * b) is the parity of a & b. PARITY compares the two, a few popcounts per
+// product, and catches every fault that flips an odd number of product bits. ROTATED also recomputes the product
+// from operands rotated by ROTATION (a^(2^k) * b^(2^k) = (a * b)^(2^k)), which takes another multiplication but
+// sends the data through different words and lanes, so even-weight faults and stuck bits show up too. On a
+// detected fault the result is zeroed and false is returned, so no faulty product leaves the multiplier.
+class CheckedMultiplier {
+public:
+    using Words = PalindromicMultiplier::Words;
+    using Kernel = PalindromicMultiplier::Kernel;
+
+    enum Mode { PARITY, ROTATED };
+
+    static const int ROTATION = 117;
+
+private:
+    static const int m = 233;
+    static constexpr uint64_t topMask = (uint64_t(1) << (m - 192)) - 1;
+
+    static Words shiftLeft(const Words& x, int k) {
+        Words r{};
+        int words = k / 64, bits = k % 64;
+        for (int w = 3; w >= words; --w) {
+            r[w] = x[w - words] << bits;
+            if (bits && w - words > 0) r[w] |= x[w - words - 1] >> (64 - bits);
+        }
+        return r;
+    }
+
+    static Words shiftRight(const Words& x, int k) {
+        Words r{};
+        int words = k / 64, bits = k % 64;
+        for (int w = 0; w + words < 4; ++w) {
+            r[w] = x[w + words] >> bits;
+            if (bits && w + words < 3) r[w] |= x[w + words + 1] << (64 - bits);
+        }
+        return r;
+    }
+
+public:
+    static int parity(const Words& x) {
+        return __builtin_parityll(x[0] ^ x[1] ^ x[2] ^ x[3]);
+    }
+
+    // Tr(a * b), without multiplying
+    static int predictParity(const Words& a, const Words& b) {
+        return __builtin_parityll((a[0] & b[0]) ^ (a[1] & b[1]) ^ (a[2] & b[2]) ^ (a[3] & b[3]));
+    }
+
+    // coefficient i moves to i + k (mod m) in the GF2mElement::toWords order, which is GF2mElement::frobenius(-k)
+    static Words rotate(const Words& x, int k) {
+        k = (k % m + m) % m;
+        if (k == 0) return x;
+        Words left = shiftLeft(x, k), right = shiftRight(x, m - k);
+        Words r;
+        for (int w = 0; w < 4; ++w) r[w] = left[w] | right[w];
+        r[3] &= topMask;
+        return r;
+    }
+
+    // c = a * b in the GF2mElement::toWords order; false (and c zero) if a fault was detected
+    static bool multiply(const Words& a, const Words& b, Words& c, Mode mode = PARITY,
+                         Kernel k = PalindromicMultiplier::kernel()) {
+        c = PalindromicMultiplier::multiply(a, b, k);
+        bool ok = parity(c) == predictParity(a, b);
+        if (ok && mode == ROTATED) {
+            Words again = PalindromicMultiplier::multiply(rotate(a, ROTATION), rotate(b, ROTATION), k);
+            ok = rotate(again, m - ROTATION) == c;
+        }
+        if (!ok) c = Words{};
+        return ok;
+    }
+
+    // the parity check on operands kept in palindromic form, a permutation of the coefficients that keeps both sides
+    static bool multiplyPalindromic(const Words& a, const Words& b, Words& c, Kernel k = PalindromicMultiplier::kernel()) {
+        c = PalindromicMultiplier::multiplyPalindromic(a, b, k);
+        bool ok = parity(c) == predictParity(a, b);
+        if (!ok) c = Words{};
+        return ok;
+    }
+};
+
+#endif //LW4_CHECKEDMULTIPLIER_H
@@ -0,0 +1,364 @@
+#ifndef LW4_DIFFERENTIALTESTER_H
+#define LW4_DIFFERENTIALTESTER_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "CheckedMultiplier.h"
+#include "GF2mBitsliced.h"
+#include "GF2mDoubled.h"
+#include "GF2mElement.h"
+#include "GF2mPalindromic.h"
+#include "Metrics.h"
+#include "NormalBasisSearch.h"
+
+// Checks every fast multiplication and inversion kernel against the bit-serial Massey-Omura product
+// (GF2mElement::multiplyAndShift, the original semantics): products must equal it bit for bit, and inverses must
+// give the all-ones element 1 under it (0 maps to 0). Inputs come in batches of 64 so the bitsliced engine sees
+// full lanes; besides uniform elements they mix in 0, 1, single bits and their complements, low weight, and
+// pairs of conjugates b = a^(2^k).
+class DifferentialTester {
+public:
+    using Words = std::array<uint64_t, 4>;
+    using Batch = std::vector<Words>;
+
+    struct MultiplyBackend {
+        std::string name;
+        std::function<Batch(const Batch&, const Batch&)> multiply;
+    };
+
+    struct InverseBackend {
+        std::string name;
+        std::function<Batch(const Batch&)> invert;
+    };
+
+    struct Mismatch {
+        std::string backend;
+        Words a;
+        Words b; // zero for inversions
+        Words expected;
+        Words actual;
+    };
+
+    static const int BATCH = GF2mBitsliced::LANES;
+
+private:
+    static const int m = 233;
+    static constexpr uint64_t topMask = (uint64_t(1) << (m - 192)) - 1;
+
+    std::vector<MultiplyBackend> multipliers;
+    std::vector<InverseBackend> inverters;
+    std::atomic<uint64_t> pairs{0};
+    std::atomic<uint64_t> comparisons{0};
+    std::atomic<uint64_t> failures{0};
+    std::mutex mismatchMutex;
+    std::vector<Mismatch> mismatches;
+    size_t maxMismatches;
+
+    // optional, per backend in the order multipliers then inverters
+    std::vector<Metrics::Counter*> checkedMetrics, mismatchMetrics;
+    Metrics::Counter* inputMetric = nullptr;
+    Metrics::Histogram* batchSeconds = nullptr;
+    Metrics::Histogram* batchFill = nullptr;
+    Metrics::Gauge* queueDepth = nullptr;
+
+    template <typename F>
+    static Batch each(const Batch& a, const Batch& b, F f) {
+        Batch c(a.size());
+        for (size_t i = 0; i < a.size(); ++i) c[i] = f(a[i], b[i]);
+        return c;
+    }
+
+    static Words one() {
+        return Words{~uint64_t(0), ~uint64_t(0), ~uint64_t(0), topMask};
+    }
+
+    static Words reference(const Words& a, const Words& b) {
+        return GF2mElement(GF2mElement::multiplyAndShift(GF2mElement::fromWords(a), GF2mElement::fromWords(b), m)).toWords();
+    }
+
+    void addBackends() {
+        using PM = PalindromicMultiplier;
+        multipliers.push_back({"operator*", [](const Batch& a, const Batch& b) {
+            return each(a, b, [](const Words& x, const Words& y) {
+                return (GF2mElement::fromWords(x) * GF2mElement::fromWords(y)).toWords();
+            });
+        }});
+        multipliers.push_back({"sparse", [](const Batch& a, const Batch& b) {
+            return each(a, b, [](const Words& x, const Words& y) {
+                return GF2mElement::fromWords(x).multiplySparse(GF2mElement::fromWords(y)).toWords();
+            });
+        }});
+        multipliers.push_back({"palindromic-comb", [](const Batch& a, const Batch& b) {
+            return each(a, b, [](const Words& x, const Words& y) { return PM::multiply(x, y, PM::COMB); });
+        }});
+        if (PM::kernel() == PM::CLMUL) {
+            multipliers.push_back({"palindromic-clmul", [](const Batch& a, const Batch& b) {
+                return each(a, b, [](const Words& x, const Words& y) { return PM::multiply(x, y, PM::CLMUL); });
+            }});
+        }
+        multipliers.push_back({"checked-rotated", [](const Batch& a, const Batch& b) {
+            return each(a, b, [](const Words& x, const Words& y) {
+                Words z;
+                CheckedMultiplier::multiply(x, y, z, CheckedMultiplier::ROTATED);
+                return z;
+            });
+        }});
+        multipliers.push_back({"doubled", [](const Batch& a, const Batch& b) {
+            return each(a, b, [](const Words& x, const Words& y) { return (GF2mDoubled(x) * GF2mDoubled(y)).toWords(); });
+        }});
+        // the same multiplier driven by the type II table as NormalBasis exports it
+        auto table = std::make_shared<std::vector<std::pair<int, int>>>();
+        GF2mDoubled::offsets(NormalBasisSearch::gaussianTable(GF2mDoubled::m, 2), *table);
+        multipliers.push_back({"doubled-table", [table](const Batch& a, const Batch& b) {
+            return each(a, b, [&table](const Words& x, const Words& y) {
+                return GF2mDoubled(x).multiply(GF2mDoubled(y), *table).toWords();
+            });
+        }});
+        multipliers.push_back({"bitsliced", [](const Batch& a, const Batch& b) {
+            Batch c;
+            for (size_t i = 0; i < a.size(); i += BATCH) {
+                size_t n = std::min<size_t>(BATCH, a.size() - i);
+                std::array<Words, BATCH> x{}, y{};
+                std::copy(a.begin() + i, a.begin() + i + n, x.begin());
+                std::copy(b.begin() + i, b.begin() + i + n, y.begin());
+                auto z = (GF2mBitsliced::pack(x) * GF2mBitsliced::pack(y)).unpack();
+                c.insert(c.end(), z.begin(), z.begin() + n);
+            }
+            return c;
+        }});
+
+        inverters.push_back({"itoh-tsujii", [](const Batch& a) {
+            return each(a, a, [](const Words& x, const Words&) { return GF2mElement::fromWords(x).inverse().toWords(); });
+        }});
+        // a^(2^m - 2)
+        inverters.push_back({"fermat", [](const Batch& a) {
+            static const std::string exponent = std::string(m - 1, '1') + "0";
+            return each(a, a, [](const Words& x, const Words&) { return GF2mElement::fromWords(x).power(exponent).toWords(); });
+        }});
+        // Montgomery's trick over the nonzero entries of the batch
+        inverters.push_back({"batch-montgomery", [](const Batch& a) {
+            Batch prefix(a.size()), result(a.size(), Words{});
+            Words running = one();
+            for (size_t i = 0; i < a.size(); ++i) {
+                prefix[i] = running;
+                if (a[i] != Words{}) running = PM::multiply(running, a[i]);
+            }
+            Words inv = GF2mElement::fromWords(running).inverse().toWords();
+            for (size_t i = a.size(); i-- > 0;) {
+                if (a[i] == Words{}) continue;
+                result[i] = PM::multiply(inv, prefix[i]);
+                inv = PM::multiply(inv, a[i]);
+            }
+            return result;
+        }});
+    }
+
+    void record(size_t index, const std::string& backend, const Words& a, const Words& b, const Words& expected,
+                const Words& actual) {
+        failures.fetch_add(1);
+        if (!mismatchMetrics.empty()) mismatchMetrics[index]->add();
+        std::lock_guard<std::mutex> lock(mismatchMutex);
+        if (mismatches.size() < maxMismatches) mismatches.push_back({backend, a, b, expected, actual});
+    }
+
+    static Words unit(int i) {
+        Words w{};
+        w[i / 64] = uint64_t(1) << (i % 64);
+        return w;
+    }
+
+    static Words complement(const Words& x) {
+        Words c = one();
+        for (int w = 0; w < 4; ++w) c[w] ^= x[w];
+        return c;
+    }
+
+public:
+    explicit DifferentialTester(size_t maxMismatches = 16) : maxMismatches(maxMismatches) {
+        addBackends();
+    }
+
+    const std::vector<MultiplyBackend>& getMultipliers() const { return multipliers; }
+    const std::vector<InverseBackend>& getInverters() const { return inverters; }
+    uint64_t getPairs() const { return pairs.load(); }
+    uint64_t getComparisons() const { return comparisons.load(); }
+    uint64_t getFailures() const { return failures.load(); }
+    std::vector<Mismatch> getMismatches() {
+        std::lock_guard<std::mutex> lock(mismatchMutex);
+        return mismatches;
+    }
+
+    // counts checks and mismatches per backend, batch times and fill, and the batches still queued in check;
+    // call before checking starts
+    void setMetrics(Metrics& metrics) {
+        std::vector<std::string> names;
+        for (const auto& backend : multipliers) names.push_back(backend.name);
+        for (const auto& backend : inverters) names.push_back(backend.name);
+        for (const std::string& name : names) {
+            std::string labels = "backend=\"" + name + "\"";
+            checkedMetrics.push_back(&metrics.counter("lw4_verify_checks_total", "Results compared with the reference", labels));
+            mismatchMetrics.push_back(&metrics.counter("lw4_verify_mismatches_total", "Results that differed from the reference", labels));
+        }
+        inputMetric = &metrics.counter("lw4_verify_inputs_total", "Input pairs checked");
+        batchSeconds = &metrics.histogram("lw4_verify_batch_seconds", "Time to check one batch on every backend",
+                                          {0.01, 0.03, 0.1, 0.3, 1, 3});
+        batchFill = &metrics.histogram("lw4_verify_batch_fill_ratio", "Inputs per batch over the 64 bitsliced lanes",
+                                       {0.25, 0.5, 0.75, 1});
+        queueDepth = &metrics.gauge("lw4_verify_queued_batches", "Batches not yet taken by a thread");
+        std::string kernel = PalindromicMultiplier::kernelName(PalindromicMultiplier::kernel());
+        metrics.gauge("lw4_multiplier_kernel", "Polynomial multiplication kernel in use", "kernel=\"" + kernel + "\"").set(1);
+    }
+
+    static Words random(std::mt19937_64& rng) {
+        Words w{rng(), rng(), rng(), rng()};
+        w[3] &= topMask;
+        return w;
+    }
+
+    // uniform most of the time, otherwise one of the shapes fast kernels tend to get wrong
+    static std::pair<Words, Words> randomPair(std::mt19937_64& rng) {
+        Words a = random(rng), b = random(rng);
+        switch (rng() % 8) {
+            case 0: { // low weight
+                Words sparse{};
+                for (int k = static_cast<int>(rng() % 4); k >= 0; --k) {
+                    Words u = unit(static_cast<int>(rng() % m));
+                    for (int w = 0; w < 4; ++w) sparse[w] ^= u[w];
+                }
+                b = rng() & 1 ? complement(sparse) : sparse;
+                break;
+            }
+            case 1: // conjugates
+                b = GF2mElement::fromWords(a).frobenius(static_cast<int>(rng() % m)).toWords();
+                break;
+            case 2: // squares
+                b = a;
+                break;
+            default:
+                break;
+        }
+        if (rng() & 1) std::swap(a, b);
+        return {a, b};
+    }
+
+    // 0 and 1 against everything, every single bit and its complement against a random element, rotation pairs
+    static std::vector<std::pair<Words, Words>> edgeCases(std::mt19937_64& rng) {
+        std::vector<Words> constants = {Words{}, one()};
+        std::vector<std::pair<Words, Words>> cases;
+        for (const Words& x : constants) {
+            for (const Words& y : constants) cases.emplace_back(x, y);
+            cases.emplace_back(x, random(rng));
+            cases.emplace_back(x, unit(static_cast<int>(rng() % m)));
+        }
+        for (int i = 0; i < m; ++i) {
+            cases.emplace_back(unit(i), random(rng));
+            cases.emplace_back(complement(unit(i)), random(rng));
+            cases.emplace_back(unit(i), unit((i * 7 + 3) % m));
+        }
+        for (int k = 1; k < m; k += 29) {
+            Words a = random(rng);
+            cases.emplace_back(a, GF2mElement::fromWords(a).frobenius(k).toWords());
+        }
+        return cases;
+    }
+
+    // every backend on one batch, against the reference
+    void checkBatch(const Batch& a, const Batch& b) {
+        auto start = std::chrono::steady_clock::now();
+        Batch expected(a.size());
+        for (size_t i = 0; i < a.size(); ++i) expected[i] = reference(a[i], b[i]);
+        size_t index = 0;
+        for (const auto& backend : multipliers) {
+            Batch actual = backend.multiply(a, b);
+            for (size_t i = 0; i < a.size(); ++i) {
+                if (actual[i] != expected[i]) record(index, backend.name, a[i], b[i], expected[i], actual[i]);
+            }
+            comparisons.fetch_add(a.size());
+            if (!checkedMetrics.empty()) checkedMetrics[index]->add(a.size());
+            ++index;
+        }
+        for (const auto& backend : inverters) {
+            Batch actual = backend.invert(a);
+            for (size_t i = 0; i < a.size(); ++i) {
+                bool zero = a[i] == Words{};
+                Words check = zero ? actual[i] : reference(a[i], actual[i]);
+                Words want = zero ? Words{} : one();
+                if (check != want) record(index, backend.name, a[i], Words{}, want, check);
+            }
+            comparisons.fetch_add(a.size());
+            if (!checkedMetrics.empty()) checkedMetrics[index]->add(a.size());
+            ++index;
+        }
+        pairs.fetch_add(a.size());
+        if (inputMetric) {
+            inputMetric->add(a.size());
+            batchFill->observe(static_cast<double>(a.size()) / BATCH);
+            batchSeconds->observe(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+    }
+
+    // the given pairs, in batches spread over threads; true if nothing mismatched
+    bool check(const std::vector<std::pair<Words, Words>>& cases, int threads) {
+        std::atomic<size_t> next(0);
+        std::vector<std::thread> pool;
+        for (int t = 0; t < std::max(1, threads); ++t) {
+            pool.emplace_back([&] {
+                for (size_t from; (from = next.fetch_add(BATCH)) < cases.size();) {
+                    size_t to = std::min(cases.size(), from + BATCH);
+                    if (queueDepth) queueDepth->set(static_cast<double>((cases.size() - to + BATCH - 1) / BATCH));
+                    Batch a, b;
+                    for (size_t i = from; i < to; ++i) {
+                        a.push_back(cases[i].first);
+                        b.push_back(cases[i].second);
+                    }
+                    checkBatch(a, b);
+                }
+            });
+        }
+        for (auto& th : pool) th.join();
+        return failures.load() == 0;
+    }
+
+    // random batches on every thread until the deadline (seconds <= 0: until stop is set), calling report about
+    // once per interval from the first thread
+    bool soak(double seconds, int threads, uint64_t seed, const std::atomic<bool>& stop,
+              const std::function<void()>& report = nullptr, double interval = 10) {
+        auto start = std::chrono::steady_clock::now();
+        auto elapsed = [&] { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); };
+        std::vector<std::thread> pool;
+        for (int t = 0; t < std::max(1, threads); ++t) {
+            pool.emplace_back([&, t] {
+                std::mt19937_64 rng(seed + t);
+                double lastReport = 0;
+                while (!stop.load() && (seconds <= 0 || elapsed() < seconds)) {
+                    Batch a, b;
+                    for (int i = 0; i < BATCH; ++i) {
+                        auto [x, y] = randomPair(rng);
+                        a.push_back(x);
+                        b.push_back(y);
+                    }
+                    checkBatch(a, b);
+                    if (t == 0 && report && elapsed() - lastReport >= interval) {
+                        lastReport = elapsed();
+                        report();
+                    }
+                }
+            });
+        }
+        for (auto& th : pool) th.join();
+        return failures.load() == 0;
+    }
+};
+
+#endif //LW4_DIFFERENTIALTESTER_H
@@ -0,0 +1,222 @@
+#ifndef LW4_ELEMENTSORT_H
+#define LW4_ELEMENTSORT_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "ForkJoinGroup.h"
+#include "GF2mDoubled.h"
+#include "GF2mElement.h"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Equality, hashing, ordering and deduplication for large sets of packed elements (the GF2mElement::toWords
+// form). The order is that of the words as a 233-bit number, word 3 most significant. sort is a parallel radix
+// sort with 16-bit digits on a ForkJoinGroup, most significant digit first: every thread counts the top digit of
+// its slice and scatters it to offsets prefix-summed digit-major, thread-minor, then the threads take buckets in
+// turn and finish them with the next digits, down to std::sort below 16K elements. Digits that all keys share
+// (such as the unused top bits, or the leading zeros of canonical elements) are skipped. Least significant digit
+// first would need 15 full scatters of 32-byte keys and ran three times slower than std::sort. canonical maps an
+// element to its smallest rotation, the same for the whole conjugacy class {a^(2^k)}, so canonicalize +
+// sortUnique leaves one representative per class.
+class ElementSort {
+public:
+    using Words = std::array<uint64_t, 4>;
+
+    struct Hash {
+        size_t operator()(const Words& x) const { return static_cast<size_t>(hash(x)); }
+    };
+
+private:
+    static const int m = 233;
+    static const int DIGIT_BITS = 16;
+    static const int BUCKETS = 1 << DIGIT_BITS;
+    static const int DIGITS = (m + DIGIT_BITS - 1) / DIGIT_BITS;
+    // below this std::sort beats the passes over the bucket counts
+    static const size_t RADIX_THRESHOLD = 1 << 14;
+
+    static uint64_t mix(uint64_t h) {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    static size_t digit(const Words& x, int d) {
+        int bit = d * DIGIT_BITS;
+        return (x[bit / 64] >> (bit % 64)) & (BUCKETS - 1);
+    }
+
+    // [from, to) of thread t out of threads over n items
+    static std::pair<size_t, size_t> slice(size_t n, int t, int threads) {
+        return {n * t / threads, n * (t + 1) / threads};
+    }
+
+    // sequential MSD pass over [items, items + n) on digit d and below, with scratch of the same length
+    static void sortRange(Words* items, Words* scratch, size_t n, int d) {
+        for (; d >= 0 && n >= RADIX_THRESHOLD; --d) {
+            std::vector<size_t> start(BUCKETS + 1);
+            for (size_t i = 0; i < n; ++i) ++start[digit(items[i], d) + 1];
+            if (std::find(start.begin(), start.end(), n) != start.end()) continue;
+            for (size_t b = 0; b < BUCKETS; ++b) start[b + 1] += start[b];
+            std::vector<size_t> next(start.begin(), start.end() - 1);
+            for (size_t i = 0; i < n; ++i) scratch[next[digit(items[i], d)]++] = items[i];
+            std::copy(scratch, scratch + n, items);
+            for (size_t b = 0; b < BUCKETS; ++b) {
+                size_t size = start[b + 1] - start[b];
+                if (size > 1) sortRange(items + start[b], scratch + start[b], size, d - 1);
+            }
+            return;
+        }
+        if (d >= 0) std::sort(items, items + n, less);
+    }
+
+public:
+    static bool equal(const Words& a, const Words& b) {
+#if defined(__AVX2__)
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a.data()));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b.data()));
+        return _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)) == -1;
+#elif defined(__SSE2__)
+        const __m128i* pa = reinterpret_cast<const __m128i*>(a.data());
+        const __m128i* pb = reinterpret_cast<const __m128i*>(b.data());
+        __m128i low = _mm_cmpeq_epi8(_mm_loadu_si128(pa), _mm_loadu_si128(pb));
+        __m128i high = _mm_cmpeq_epi8(_mm_loadu_si128(pa + 1), _mm_loadu_si128(pb + 1));
+        return _mm_movemask_epi8(_mm_and_si128(low, high)) == 0xffff;
+#else
+        return ((a[0] ^ b[0]) | (a[1] ^ b[1]) | (a[2] ^ b[2]) | (a[3] ^ b[3])) == 0;
+#endif
+    }
+
+    static bool less(const Words& a, const Words& b) {
+        for (int w = 3; w >= 0; --w) {
+            if (a[w] != b[w]) return a[w] < b[w];
+        }
+        return false;
+    }
+
+    // 64-bit hash of the packed words, one multiply-xorshift round per word
+    static uint64_t hash(const Words& x) {
+        uint64_t h = 0x9e3779b97f4a7c15ULL;
+        for (int w = 0; w < 4; ++w) h = mix(h ^ x[w]) + 0x9e3779b97f4a7c15ULL;
+        return mix(h);
+    }
+
+    // the smallest of the m rotations, i.e. of the conjugates a^(2^k)
+    static Words canonical(const Words& x) {
+        GF2mDoubled doubled(x);
+        Words best = doubled.window(0);
+        for (int s = 1; s < m; ++s) {
+            Words rotated = doubled.window(s);
+            if (less(rotated, best)) best = rotated;
+        }
+        return best;
+    }
+
+    static void canonicalize(std::vector<Words>& items, ForkJoinGroup& group) {
+        int threads = group.getSize();
+        group.run([&](int t) {
+            auto [from, to] = slice(items.size(), t, threads);
+            for (size_t i = from; i < to; ++i) items[i] = canonical(items[i]);
+        });
+    }
+
+    static void sort(std::vector<Words>& items, ForkJoinGroup& group) {
+        size_t n = items.size();
+        if (n < RADIX_THRESHOLD) {
+            std::sort(items.begin(), items.end(), less);
+            return;
+        }
+        int threads = group.getSize();
+        std::vector<std::vector<size_t>> counts(threads, std::vector<size_t>(BUCKETS));
+        int d = DIGITS - 1;
+        std::vector<size_t> bucketStart(BUCKETS + 1);
+        for (;; --d) {
+            if (d < 0) return; // all equal
+            group.run([&](int t) {
+                auto [from, to] = slice(n, t, threads);
+                std::vector<size_t>& count = counts[t];
+                std::fill(count.begin(), count.end(), 0);
+                for (size_t i = from; i < to; ++i) ++count[digit(items[i], d)];
+            });
+            // counts become the scatter offsets of each thread, digit-major and thread-minor
+            bool trivial = false;
+            size_t offset = 0;
+            for (size_t b = 0; b < BUCKETS; ++b) {
+                bucketStart[b] = offset;
+                size_t total = 0;
+                for (int t = 0; t < threads; ++t) {
+                    size_t c = counts[t][b];
+                    counts[t][b] = offset + total;
+                    total += c;
+                }
+                if (total == n) trivial = true;
+                offset += total;
+            }
+            bucketStart[BUCKETS] = n;
+            if (!trivial) break;
+        }
+
+        std::vector<Words> buffer(n);
+        group.run([&](int t) {
+            auto [from, to] = slice(n, t, threads);
+            std::vector<size_t>& next = counts[t];
+            for (size_t i = from; i < to; ++i) buffer[next[digit(items[i], d)]++] = items[i];
+        });
+        items.swap(buffer);
+
+        std::atomic<size_t> nextBucket(0);
+        group.run([&](int) {
+            for (size_t b; (b = nextBucket.fetch_add(1)) < BUCKETS;) {
+                size_t from = bucketStart[b], size = bucketStart[b + 1] - from;
+                if (size > 1) sortRange(items.data() + from, buffer.data() + from, size, d - 1);
+            }
+        });
+    }
+
+    // drops repeats from sorted items, compacting each thread's slice in parallel; returns the number left
+    static size_t unique(std::vector<Words>& items, ForkJoinGroup& group) {
+        size_t n = items.size();
+        int threads = group.getSize();
+        std::vector<size_t> kept(threads + 1);
+        group.run([&](int t) {
+            auto [from, to] = slice(n, t, threads);
+            size_t count = 0;
+            for (size_t i = from; i < to; ++i) count += i == 0 || !equal(items[i], items[i - 1]);
+            kept[t + 1] = count;
+        });
+        for (int t = 0; t < threads; ++t) kept[t + 1] += kept[t];
+        std::vector<Words> result(kept[threads]);
+        group.run([&](int t) {
+            auto [from, to] = slice(n, t, threads);
+            size_t next = kept[t];
+            for (size_t i = from; i < to; ++i) {
+                if (i == 0 || !equal(items[i], items[i - 1])) result[next++] = items[i];
+            }
+        });
+        items.swap(result);
+        return items.size();
+    }
+
+    // sorted distinct items, or one canonical representative per conjugacy class
+    static size_t sortUnique(std::vector<Words>& items, ForkJoinGroup& group, bool conjugacyClasses = false) {
+        if (conjugacyClasses) canonicalize(items, group);
+        sort(items, group);
+        return unique(items, group);
+    }
+};
+
+namespace std {
+template <>
+struct hash<GF2mElement> {
+    size_t operator()(const GF2mElement& x) const { return static_cast<size_t>(ElementSort::hash(x.toWords())); }
+};
+}
+
+#endif //LW4_ELEMENTSORT_H
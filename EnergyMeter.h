@@ -0,0 +1,83 @@
+#ifndef LW4_ENERGYMETER_H
+#define LW4_ENERGYMETER_H
+
+#include <cstdint>
+#include <dirent.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Energy counters of the Linux powercap RAPL zones (intel-rapl, also used by AMD): every package zone and every
+// dram subzone, which the package counter does not include. psys covers the whole platform and would count the
+// others twice, so it is left out. The counters are cumulative microjoules that wrap at max_energy_range_uj and
+// are updated about every millisecond, so intervals should be much longer than that. They are usually readable
+// by root only; without readable zones available() is false.
+class EnergyMeter {
+public:
+    struct Domain {
+        std::string name; // package-0, dram, ...
+        std::string path; // the energy_uj file
+        uint64_t range;   // max_energy_range_uj
+    };
+
+private:
+    std::vector<Domain> domains;
+
+    static bool readNumber(const std::string& path, uint64_t& value) {
+        std::ifstream in(path);
+        return static_cast<bool>(in >> value);
+    }
+
+    static std::string readLine(const std::string& path) {
+        std::ifstream in(path);
+        std::string line;
+        std::getline(in, line);
+        return line;
+    }
+
+public:
+    explicit EnergyMeter(const std::string& root = "/sys/class/powercap") {
+        DIR* dir = opendir(root.c_str());
+        if (!dir) return;
+        std::vector<std::string> zones;
+        while (dirent* entry = readdir(dir)) {
+            std::string zone = entry->d_name;
+            if (zone.rfind("intel-rapl:", 0) == 0) zones.push_back(zone);
+        }
+        closedir(dir);
+        for (const std::string& zone : zones) {
+            std::string base = root + "/" + zone + "/";
+            std::string name = readLine(base + "name");
+            bool package = name.rfind("package", 0) == 0;
+            if (!package && name != "dram") continue;
+            uint64_t range = 0, value = 0;
+            if (!readNumber(base + "max_energy_range_uj", range) || !readNumber(base + "energy_uj", value)) continue;
+            domains.push_back({name, base + "energy_uj", range});
+        }
+    }
+
+    bool available() const { return !domains.empty(); }
+    const std::vector<Domain>& getDomains() const { return domains; }
+
+    // one reading per domain, in microjoules
+    std::vector<uint64_t> read() const {
+        std::vector<uint64_t> values;
+        for (const Domain& d : domains) {
+            uint64_t value = 0;
+            readNumber(d.path, value);
+            values.push_back(value);
+        }
+        return values;
+    }
+
+    // joules used by all domains between two readings, allowing one wrap per counter
+    double joules(const std::vector<uint64_t>& start, const std::vector<uint64_t>& stop) const {
+        uint64_t total = 0;
+        for (size_t i = 0; i < domains.size() && i < start.size() && i < stop.size(); ++i) {
+            total += stop[i] >= start[i] ? stop[i] - start[i] : domains[i].range - start[i] + stop[i];
+        }
+        return total * 1e-6;
+    }
+};
+
+#endif //LW4_ENERGYMETER_H
@@ -0,0 +1,199 @@
+#ifndef LW4_ETATPAIRING_H
+#define LW4_ETATPAIRING_H
+
+#include <vector>
+#include <string>
+#include <utility>
+#include "GF2mElement.h"
+#include "GF2mTower.h"
+
+struct SupersingularPoint {
+    GF2mElement x;
+    GF2mElement y;
+    bool infinity;
+
+    SupersingularPoint() : x(GF2mElement::zero()), y(GF2mElement::zero()), infinity(true) {}
+
+    SupersingularPoint(const GF2mElement& x, const GF2mElement& y) : x(x), y(y), infinity(false) {}
+};
+
+// E_b : y^2 + y = x^3 + x + b over GF(2^m), b in {0, 1}, m odd
+class SupersingularCurve {
+private:
+    int b;
+
+public:
+    explicit SupersingularCurve(int b) : b(b & 1) {}
+
+    int getB() const {
+        return b;
+    }
+
+    GF2mElement getBElement() const {
+        return b ? GF2mElement::one() : GF2mElement::zero();
+    }
+
+    // #E = 2^m + 1 + nu * 2^((m + 1) / 2)
+    int getNu() const {
+        int r = GF2mElement::getM() % 8;
+        bool plus = (r == 1 || r == 7);
+        return (plus == (b == 0)) ? 1 : -1;
+    }
+
+    bool isOnCurve(const SupersingularPoint& P) const {
+        if (P.infinity) return true;
+        GF2mElement lhs = P.y.squareONB() + P.y;
+        GF2mElement rhs = P.x.squareONB() * P.x + P.x + getBElement();
+        return (lhs + rhs).isZero();
+    }
+
+    // for odd m the half-trace H(c) = sum c^(2^(2i)) solves y^2 + y = c whenever Tr(c) = 0
+    static GF2mElement halfTrace(const GF2mElement& c) {
+        GF2mElement h = c;
+        for (int i = 2; i < GF2mElement::getM(); i += 2) {
+            h = h + c.frobenius(i);
+        }
+        return h;
+    }
+
+    // returns false if no point with this x-coordinate exists
+    bool liftX(const GF2mElement& x, SupersingularPoint& P) const {
+        GF2mElement c = x.squareONB() * x + x + getBElement();
+        if (c.trace()) return false;
+        P = SupersingularPoint(x, halfTrace(c));
+        return true;
+    }
+
+    SupersingularPoint negate(const SupersingularPoint& P) const {
+        if (P.infinity) return P;
+        return SupersingularPoint(P.x, P.y + GF2mElement::one());
+    }
+
+    SupersingularPoint doublePoint(const SupersingularPoint& P) const {
+        if (P.infinity) return P;
+        GF2mElement lambda = P.x.squareONB() + GF2mElement::one();
+        GF2mElement x3 = lambda.squareONB();
+        GF2mElement y3 = lambda * (P.x + x3) + P.y + GF2mElement::one();
+        return SupersingularPoint(x3, y3);
+    }
+
+    SupersingularPoint add(const SupersingularPoint& P, const SupersingularPoint& Q) const {
+        if (P.infinity) return Q;
+        if (Q.infinity) return P;
+        GF2mElement dx = P.x + Q.x;
+        GF2mElement dy = P.y + Q.y;
+        if (dx.isZero()) {
+            if (dy.isZero()) return doublePoint(P);
+            return SupersingularPoint();
+        }
+        GF2mElement lambda = dy * dx.inverse();
+        GF2mElement x3 = lambda.squareONB() + P.x + Q.x;
+        GF2mElement y3 = lambda * (P.x + x3) + P.y + GF2mElement::one();
+        return SupersingularPoint(x3, y3);
+    }
+
+    // scalar is a binary string, most significant bit first, as in GF2mElement::power
+    SupersingularPoint multiply(const SupersingularPoint& P, const std::string& scalar) const {
+        SupersingularPoint result;
+        for (char bit : scalar) {
+            result = doublePoint(result);
+            if (bit == '1') {
+                result = add(result, P);
+            }
+        }
+        return result;
+    }
+};
+
+// eta_T pairing on E_b with GF(2^4m) = GF(2^m)[s, t], s^2 = s + 1, t^2 = t + s
+// (Beuchat et al., "A comparison between hardware accelerators for the modified Tate pairing over F_2^m and F_3^m")
+class EtaTPairing {
+private:
+    SupersingularCurve curve;
+    int alpha;
+    int beta;
+    int delta;
+
+    static GF2mElement constant(int bit) {
+        return bit ? GF2mElement::one() : GF2mElement::zero();
+    }
+
+public:
+    explicit EtaTPairing(const SupersingularCurve& curve) : curve(curve) {
+        int r = GF2mElement::getM() % 8;
+        int b = curve.getB();
+        alpha = (r == 3 || r == 7) ? 1 : 0;
+        beta = (r == 1 || r == 7) ? b : 1 - b;
+        delta = (r == 1 || r == 7) ? b : 1 - b;
+    }
+
+    const SupersingularCurve& getCurve() const {
+        return curve;
+    }
+
+    // unreduced eta_T(P, Q); x_P, y_P walk through square roots and x_Q, y_Q through squares,
+    // both of which are rotations in the normal basis
+    GF2m4Element millerLoop(const SupersingularPoint& P, const SupersingularPoint& Q) const {
+        if (P.infinity || Q.infinity) return GF2m4Element::one();
+
+        GF2mElement xP = P.x;
+        GF2mElement yP = P.y + constant(1 - delta);
+        GF2mElement xQ = Q.x;
+        GF2mElement yQ = Q.y;
+
+        GF2mElement u = xP + constant(alpha);
+        GF2mElement v = xQ + constant(alpha);
+        GF2mElement g0 = u * v + yP + yQ + constant(beta);
+        GF2mElement g1 = u + xQ;
+        GF2mElement g2 = v + xP.squareONB();
+
+        GF2m2Element G(g0, g1);
+        GF2m2Element L(g0 + g2, g1 + GF2mElement::one());
+        GF2m4Element F = GF2m4Element(L, GF2m2Element::one()).mulByLine(G);
+
+        for (int j = 1; j <= (GF2mElement::getM() - 1) / 2; ++j) {
+            xP = xP.sqrtONB();
+            yP = yP.sqrtONB();
+            xQ = xQ.squareONB();
+            yQ = yQ.squareONB();
+
+            u = xP + constant(alpha);
+            v = xQ + constant(alpha);
+            g0 = u * v + yP + yQ + constant(beta);
+            g1 = u + xQ;
+            F = F.mulByLine(GF2m2Element(g0, g1));
+        }
+        return F;
+    }
+
+    // F^M with M = (2^2m - 1)(2^m + 1 - nu * 2^((m + 1) / 2)) = (2^4m - 1) / #E
+    GF2m4Element finalExponentiation(const GF2m4Element& F) const {
+        int m = GF2mElement::getM();
+        GF2m4Element U = F.conjugate() * F.inverse();
+
+        GF2m4Element V = U;
+        for (int i = 0; i < (m + 1) / 2; ++i) {
+            V = V.square();
+        }
+        // U is unitary after the first step, so its inverse is the conjugate
+        if (curve.getNu() > 0) {
+            V = V.conjugate();
+        }
+        return U.frobenius(m) * U * V;
+    }
+
+    GF2m4Element pair(const SupersingularPoint& P, const SupersingularPoint& Q) const {
+        return finalExponentiation(millerLoop(P, Q));
+    }
+
+    // prod e(P_i, Q_i): one Miller loop per pair, a single shared final exponentiation
+    GF2m4Element multiPairing(const std::vector<std::pair<SupersingularPoint, SupersingularPoint>>& pairs) const {
+        GF2m4Element F = GF2m4Element::one();
+        for (const auto& [P, Q] : pairs) {
+            F = F * millerLoop(P, Q);
+        }
+        return finalExponentiation(F);
+    }
+};
+
+#endif //LW4_ETATPAIRING_H
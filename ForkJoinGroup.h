@@ -0,0 +1,117 @@
+#ifndef LW4_FORKJOINGROUP_H
+#define LW4_FORKJOINGROUP_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// A fixed group of threads for fork-join calls on the latency path: run(task) calls task(0) on the caller and
+// task(1) .. task(size - 1) on the workers, and returns once all of them are done. The workers stay alive
+// between calls and spin for a while after each one before they block, so back-to-back calls skip the wake-up
+// latency (unless the group has more threads than the machine has CPUs). Pinning puts worker i on CPU i. A
+// group serves one caller at a time.
+class ForkJoinGroup {
+private:
+    int size;
+    int spin;
+    std::vector<std::thread> workers;
+    std::function<void(int)> task;
+    std::atomic<uint64_t> generation{0};
+    std::atomic<int> pending{0};
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+
+    static void pause() {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    static void pin(std::thread::native_handle_type handle, int cpu) {
+#ifdef __linux__
+        int cpus = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu % cpus, &set);
+        pthread_setaffinity_np(handle, sizeof(set), &set);
+#else
+        (void) handle;
+        (void) cpu;
+#endif
+    }
+
+    void work(int index) {
+        uint64_t seen = 0;
+        while (true) {
+            for (int i = 0; i < spin && generation.load(std::memory_order_acquire) == seen; ++i) pause();
+            if (generation.load(std::memory_order_acquire) == seen) {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return generation.load(std::memory_order_acquire) != seen; });
+            }
+            seen = generation.load(std::memory_order_acquire);
+            if (stopping) return;
+            task(index);
+            pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+public:
+    explicit ForkJoinGroup(int size = 0, bool pinned = false) : size(size) {
+        int cpus = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        if (this->size <= 0) this->size = cpus;
+        spin = this->size <= cpus ? 1 << 12 : 0;
+        for (int i = 1; i < this->size; ++i) {
+            workers.emplace_back([this, i] { work(i); });
+            if (pinned) pin(workers.back().native_handle(), i);
+        }
+    }
+
+    ForkJoinGroup(const ForkJoinGroup&) = delete;
+    ForkJoinGroup& operator=(const ForkJoinGroup&) = delete;
+
+    ~ForkJoinGroup() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+            generation.fetch_add(1, std::memory_order_release);
+        }
+        wake.notify_all();
+        for (auto& worker : workers) worker.join();
+    }
+
+    int getSize() const { return size; }
+
+    void run(const std::function<void(int)>& work) {
+        task = work;
+        pending.store(size - 1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            generation.fetch_add(1, std::memory_order_release);
+        }
+        wake.notify_all();
+        task(0);
+        for (int i = 0; pending.load(std::memory_order_acquire) > 0; ++i) {
+            if (i < spin) pause();
+            else std::this_thread::yield();
+        }
+    }
+};
+
+#endif //LW4_FORKJOINGROUP_H
@@ -0,0 +1,116 @@
+#ifndef LW4_GF2MBITSLICED_H
+#define LW4_GF2MBITSLICED_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include "BitMatrix.h"
+#include "GF2mDoubled.h"
+
+// 64 elements of GF(2^233) at once, one per bit lane: slice i holds coefficient i (the GF2mElement::toWords
+// order) of all 64 elements, bit t for lane t. Every field operation is then the same straight-line word code
+// for all lanes, so there are no data-dependent branches or table lookups, and lane-wise choices are masks.
+class GF2mBitsliced {
+public:
+    using Words = std::array<uint64_t, 4>;
+    static const int m = 233;
+    static const int LANES = 64;
+
+private:
+    std::array<uint64_t, m> slices{};
+
+public:
+    GF2mBitsliced() = default;
+
+    // the same element in every lane
+    static GF2mBitsliced broadcast(const Words& element) {
+        GF2mBitsliced result;
+        for (int i = 0; i < m; ++i) result.slices[i] = ((element[i / 64] >> (i % 64)) & 1) ? ~uint64_t(0) : 0;
+        return result;
+    }
+
+    // lanes[t] goes to lane t; each 64-coefficient word is one 64x64 bit transpose
+    static GF2mBitsliced pack(const std::array<Words, LANES>& lanes) {
+        GF2mBitsliced result;
+        uint64_t in[64], out[64];
+        for (int w = 0; w < 4; ++w) {
+            for (int t = 0; t < LANES; ++t) in[t] = lanes[t][w];
+            BitMatrix::transpose64(in, out);
+            for (int i = 0; i < 64 && 64 * w + i < m; ++i) result.slices[64 * w + i] = out[i];
+        }
+        return result;
+    }
+
+    std::array<Words, LANES> unpack() const {
+        std::array<Words, LANES> lanes;
+        uint64_t in[64], out[64];
+        for (int w = 0; w < 4; ++w) {
+            for (int i = 0; i < 64; ++i) in[i] = 64 * w + i < m ? slices[64 * w + i] : 0;
+            BitMatrix::transpose64(in, out);
+            for (int t = 0; t < LANES; ++t) lanes[t][w] = out[t];
+        }
+        return lanes;
+    }
+
+    GF2mBitsliced operator+(const GF2mBitsliced& other) const {
+        GF2mBitsliced result;
+        for (int i = 0; i < m; ++i) result.slices[i] = slices[i] ^ other.slices[i];
+        return result;
+    }
+
+    // the 2^k-th power: squaring moves coefficient i + 1 to i, so this only renames slices
+    GF2mBitsliced frobenius(int k) const {
+        k %= m;
+        if (k < 0) k += m;
+        GF2mBitsliced result;
+        std::rotate_copy(slices.begin(), slices.begin() + k, slices.end(), result.slices.begin());
+        return result;
+    }
+
+    GF2mBitsliced square() const {
+        return frobenius(1);
+    }
+
+    // Massey-Omura over the lambda entries of GF2mDoubled: coefficient c gets a[c + sa] & b[c + sb] for each
+    // entry (sa, sb). Both operands are laid out twice so the inner loop over c runs over contiguous slices.
+    GF2mBitsliced operator*(const GF2mBitsliced& other) const {
+        uint64_t x[2 * m], y[2 * m];
+        std::copy(slices.begin(), slices.end(), x);
+        std::copy(slices.begin(), slices.end(), x + m);
+        std::copy(other.slices.begin(), other.slices.end(), y);
+        std::copy(other.slices.begin(), other.slices.end(), y + m);
+        GF2mBitsliced result;
+        uint64_t* r = result.slices.data();
+        for (const auto& [sa, sb] : GF2mDoubled::offsets()) {
+            const uint64_t* a = x + sa;
+            const uint64_t* b = y + sb;
+            for (int c = 0; c < m; ++c) r[c] ^= a[c] & b[c];
+        }
+        return result;
+    }
+
+    // lanes set in mask take b, the others a
+    static GF2mBitsliced select(uint64_t mask, const GF2mBitsliced& a, const GF2mBitsliced& b) {
+        GF2mBitsliced result;
+        for (int i = 0; i < m; ++i) result.slices[i] = a.slices[i] ^ (mask & (a.slices[i] ^ b.slices[i]));
+        return result;
+    }
+
+    // swaps a and b in the lanes set in mask
+    static void conditionalSwap(uint64_t mask, GF2mBitsliced& a, GF2mBitsliced& b) {
+        for (int i = 0; i < m; ++i) {
+            uint64_t t = mask & (a.slices[i] ^ b.slices[i]);
+            a.slices[i] ^= t;
+            b.slices[i] ^= t;
+        }
+    }
+
+    // bit t set when lane t is zero
+    uint64_t zeroLanes() const {
+        uint64_t any = 0;
+        for (int i = 0; i < m; ++i) any |= slices[i];
+        return ~any;
+    }
+};
+
+#endif //LW4_GF2MBITSLICED_H
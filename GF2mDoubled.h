@@ -0,0 +1,122 @@
+#ifndef LW4_GF2MDOUBLED_H
+#define LW4_GF2MDOUBLED_H
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "LambdaTable.h"
+
+// GF(2^233) in the type II ONB with the 233 coordinates stored twice back-to-back: bit i and bit i + m both hold
+// coefficient i (the GF2mElement::toWords order). A rotation by k is then the 233-bit window starting at bit k,
+// four independent funnel-shifted word loads, with no carry loop across the words.
+class GF2mDoubled {
+public:
+    using Words = std::array<uint64_t, 4>;
+    static const int m = 233;
+
+private:
+    static const int p = 2 * m + 1;
+    static const int WORDS = 8;
+    static constexpr uint64_t topMask = (uint64_t(1) << (m - 192)) - 1;
+
+    std::array<uint64_t, WORDS> bits{};
+
+public:
+    // window offsets of the lambda entries: the product is sum rotate(a, m - i) & rotate(b, m - j) over
+    // beta^(2^i) * beta^(2^j) containing beta, where coefficient c holds beta^(2^(m - 1 - c))
+    static const std::vector<std::pair<int, int>>& offsets() {
+        static const std::vector<std::pair<int, int>> result = [] {
+            std::vector<int> pow2(m);
+            pow2[0] = 1;
+            for (int i = 1; i < m; ++i) pow2[i] = pow2[i - 1] * 2 % p;
+            std::vector<std::pair<int, int>> entries;
+            for (int i = 0; i < m; ++i) {
+                for (int j = 0; j < m; ++j) {
+                    int sum = (pow2[i] + pow2[j]) % p;
+                    int diff = (pow2[i] - pow2[j] + p) % p;
+                    if (sum == 1 || sum == p - 1 || diff == 1 || diff == p - 1) {
+                        entries.emplace_back((m - i) % m, (m - j) % m);
+                    }
+                }
+            }
+            return entries;
+        }();
+        return result;
+    }
+
+    // the same offsets from a table loaded with LambdaTable::load (as written by NormalBasis), for multiplying in
+    // the basis it describes; false if the table is for another m
+    static bool offsets(const LambdaTable& table, std::vector<std::pair<int, int>>& result) {
+        if (table.m != m) return false;
+        result.clear();
+        result.reserve(table.ones.size());
+        for (const auto& [i, j] : table.ones) result.emplace_back((m - i) % m, (m - j) % m);
+        return true;
+    }
+
+    GF2mDoubled() = default;
+
+    explicit GF2mDoubled(const Words& words) {
+        for (int w = 0; w < 4; ++w) bits[w] = words[w];
+        bits[3] &= topMask;
+        // second copy starts at bit 233 = word 3, bit 41
+        for (int w = 0; w < 4; ++w) {
+            bits[3 + w] |= bits[w] << (m - 192);
+            bits[4 + w] |= bits[w] >> (256 - m);
+        }
+    }
+
+    // coefficients s .. s + m - 1, i.e. the element rotated so that coefficient i becomes coefficient i - s
+    Words window(int s) const {
+        Words out;
+        int q = s / 64, r = s % 64;
+        for (int w = 0; w < 4; ++w) {
+            out[w] = r ? (bits[q + w] >> r) | (bits[q + w + 1] << (64 - r)) : bits[q + w];
+        }
+        out[3] &= topMask;
+        return out;
+    }
+
+    Words toWords() const {
+        return window(0);
+    }
+
+    // the 2^k-th power: squaring moves coefficient i + 1 to i
+    GF2mDoubled frobenius(int k) const {
+        k %= m;
+        if (k < 0) k += m;
+        return GF2mDoubled(window(k));
+    }
+
+    GF2mDoubled square() const {
+        return frobenius(1);
+    }
+
+    GF2mDoubled operator+(const GF2mDoubled& other) const {
+        GF2mDoubled result;
+        for (int w = 0; w < WORDS; ++w) result.bits[w] = bits[w] ^ other.bits[w];
+        return result;
+    }
+
+    // word-parallel Massey-Omura: all m output bits at once, one pair of rotated windows per lambda entry;
+    // every rotation is used about twice, so they are extracted once up front
+    GF2mDoubled multiply(const GF2mDoubled& other, const std::vector<std::pair<int, int>>& table) const {
+        std::array<Words, m> x, y;
+        for (int s = 0; s < m; ++s) {
+            x[s] = window(s);
+            y[s] = other.window(s);
+        }
+        Words result{};
+        for (const auto& [sa, sb] : table) {
+            for (int w = 0; w < 4; ++w) result[w] ^= x[sa][w] & y[sb][w];
+        }
+        return GF2mDoubled(result);
+    }
+
+    GF2mDoubled operator*(const GF2mDoubled& other) const {
+        return multiply(other, offsets());
+    }
+};
+
+#endif //LW4_GF2MDOUBLED_H
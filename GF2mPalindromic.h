@@ -0,0 +1,220 @@
+#ifndef LW4_GF2MPALINDROMIC_H
+#define LW4_GF2MPALINDROMIC_H
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define LW4_HAVE_X86 1
+#endif
+
+// Type II ONB products through the palindromic form: with gamma a primitive p-th root of unity (p = 2m + 1),
+// beta^(2^i) = gamma^(2^i) + gamma^(-2^i) = b_k for k = +-2^i mod p in 1..m, and b_j b_k = b_(j+k) + b_|j-k|
+// with b_0 = 0 and b_n = b_(p-n). So a product is a permutation of the coordinates, two m-bit polynomial
+// products A * B and A * reverse(B), and a fold back to 1..m.
+//
+// The polynomial products run on the carry-less multiply instruction when the CPU has it and on a
+// López-Dahab comb with 4-bit windows otherwise; LW4_NO_CLMUL in the environment forces the comb.
+class PalindromicMultiplier {
+public:
+    using Words = std::array<uint64_t, 4>;
+    using Product = std::array<uint64_t, 8>;
+    static const int m = 233;
+
+    enum Kernel { COMB, CLMUL };
+
+private:
+    static const int p = 2 * m + 1;
+    static constexpr uint64_t topMask = (uint64_t(1) << (m - 192)) - 1;
+
+    // palindromic index k - 1 of coefficient c, which holds beta^(2^(m - 1 - c)) (GF2mElement::toWords order)
+    static const std::vector<int>& permutation() {
+        static const std::vector<int> table = [] {
+            std::vector<int> result(m);
+            int pow2 = 1;
+            for (int i = 0; i < m; ++i) {
+                int k = pow2 <= m ? pow2 : p - pow2;
+                result[m - 1 - i] = k - 1;
+                pow2 = pow2 * 2 % p;
+            }
+            return result;
+        }();
+        return table;
+    }
+
+    static const std::vector<int>& inversePermutation() {
+        static const std::vector<int> table = [] {
+            std::vector<int> result(m);
+            for (int c = 0; c < m; ++c) result[permutation()[c]] = c;
+            return result;
+        }();
+        return table;
+    }
+
+    static uint64_t reverse64(uint64_t x) {
+        x = ((x >> 1) & 0x5555555555555555ULL) | ((x & 0x5555555555555555ULL) << 1);
+        x = ((x >> 2) & 0x3333333333333333ULL) | ((x & 0x3333333333333333ULL) << 2);
+        x = ((x >> 4) & 0x0f0f0f0f0f0f0f0fULL) | ((x & 0x0f0f0f0f0f0f0f0fULL) << 4);
+        return __builtin_bswap64(x);
+    }
+
+    // bits from .. from + m - 1 of a product, as a 233-bit value
+    static Words extract(const Product& product, int from) {
+        Words out;
+        int q = from / 64, r = from % 64;
+        for (int w = 0; w < 4; ++w) {
+            uint64_t low = q + w < 8 ? product[q + w] : 0;
+            uint64_t high = q + w + 1 < 8 ? product[q + w + 1] : 0;
+            out[w] = r ? (low >> r) | (high << (64 - r)) : low;
+        }
+        out[3] &= topMask;
+        return out;
+    }
+
+    // bit i of the result is bit m - 1 - i of x
+    static Words reverse(const Words& x) {
+        // reversing 256 bits puts bit i at 255 - i, then the value is moved down by 256 - m
+        Product wide{};
+        for (int w = 0; w < 4; ++w) wide[3 - w] = reverse64(x[w]);
+        return extract(wide, 256 - m);
+    }
+
+    static Product combMultiply(const Words& a, const Words& b) {
+        // table[u] = u(x) * b(x) for every 4-bit polynomial u, five words each
+        uint64_t table[16][5] = {};
+        for (int w = 0; w < 4; ++w) {
+            table[1][w] = b[w];
+        }
+        for (int u = 2; u < 16; u += 2) {
+            // u = 2v: shift table[v] left by one; u + 1 adds b
+            const uint64_t* half = table[u / 2];
+            table[u][0] = half[0] << 1;
+            for (int w = 1; w < 5; ++w) table[u][w] = (half[w] << 1) | (half[w - 1] >> 63);
+            for (int w = 0; w < 5; ++w) table[u + 1][w] = table[u][w] ^ table[1][w];
+        }
+
+        uint64_t c[9] = {};
+        for (int nibble = 15; nibble >= 0; --nibble) {
+            for (int i = 0; i < 4; ++i) {
+                const uint64_t* row = table[(a[i] >> (4 * nibble)) & 15];
+                for (int w = 0; w < 5; ++w) c[i + w] ^= row[w];
+            }
+            if (nibble == 0) break;
+            for (int w = 8; w > 0; --w) c[w] = (c[w] << 4) | (c[w - 1] >> 60);
+            c[0] <<= 4;
+        }
+        Product product;
+        for (int w = 0; w < 8; ++w) product[w] = c[w];
+        return product;
+    }
+
+#ifdef LW4_HAVE_X86
+    __attribute__((target("pclmul,sse2")))
+    static Product clmulMultiply(const Words& a, const Words& b) {
+        __m128i acc[8];
+        for (auto& v : acc) v = _mm_setzero_si128();
+        for (int i = 0; i < 4; ++i) {
+            __m128i x = _mm_set_epi64x(0, static_cast<long long>(a[i]));
+            for (int j = 0; j < 4; ++j) {
+                __m128i y = _mm_set_epi64x(0, static_cast<long long>(b[j]));
+                acc[i + j] = _mm_xor_si128(acc[i + j], _mm_clmulepi64_si128(x, y, 0x00));
+            }
+        }
+        Product product{};
+        for (int k = 0; k < 7; ++k) {
+            uint64_t parts[2];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(parts), acc[k]);
+            product[k] ^= parts[0];
+            product[k + 1] ^= parts[1];
+        }
+        return product;
+    }
+#endif
+
+    static Kernel detect() {
+        if (std::getenv("LW4_NO_CLMUL")) return COMB;
+#ifdef LW4_HAVE_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("pclmul")) return CLMUL;
+#endif
+        return COMB;
+    }
+
+public:
+    static Kernel kernel() {
+        static const Kernel selected = detect();
+        return selected;
+    }
+
+    static const char* kernelName(Kernel k) {
+        return k == CLMUL ? "clmul" : "comb";
+    }
+
+    // the 466-bit polynomial product of two 233-bit polynomials
+    static Product polynomialMultiply(const Words& a, const Words& b, Kernel k) {
+#ifdef LW4_HAVE_X86
+        if (k == CLMUL) return clmulMultiply(a, b);
+#endif
+        (void) k;
+        return combMultiply(a, b);
+    }
+
+    static Words toPalindromic(const Words& onb) {
+        const auto& perm = permutation();
+        Words result{};
+        for (int w = 0; w < 4; ++w) {
+            for (uint64_t rest = onb[w]; rest; rest &= rest - 1) {
+                int k = perm[64 * w + __builtin_ctzll(rest)];
+                result[k / 64] |= uint64_t(1) << (k % 64);
+            }
+        }
+        return result;
+    }
+
+    static Words fromPalindromic(const Words& palindromic) {
+        const auto& inverse = inversePermutation();
+        Words result{};
+        for (int w = 0; w < 4; ++w) {
+            for (uint64_t rest = palindromic[w]; rest; rest &= rest - 1) {
+                int c = inverse[64 * w + __builtin_ctzll(rest)];
+                result[c / 64] |= uint64_t(1) << (c % 64);
+            }
+        }
+        return result;
+    }
+
+    // product of two elements in palindromic form: bit k - 1 is the coefficient of b_k
+    static Words multiplyPalindromic(const Words& a, const Words& b, Kernel k) {
+        // P = A * B holds b_(j+k) at bit j + k - 2; Q = A * reverse(B) holds b_(j-k) at bit j - k + m - 1
+        Product P = polynomialMultiply(a, b, k);
+        Product Q = polynomialMultiply(a, reverse(b), k);
+
+        // bit i of c is b_(i+1): from P at bits i - 1 and 2m - 2 - i, from Q at bits i + m and m - 2 - i
+        Words sums = extract(P, 0);
+        for (int w = 3; w > 0; --w) sums[w] = (sums[w] << 1) | (sums[w - 1] >> 63);
+        sums[0] <<= 1;
+        Words foldedSums = reverse(extract(P, m - 1));
+        Words differences = extract(Q, m);
+        Words low = extract(Q, 0);
+        low[(m - 1) / 64] &= ~(uint64_t(1) << ((m - 1) % 64));
+        Words foldedDifferences = reverse(low);
+        // reverse(low) puts bit m - 2 - i at i + 1, so move it down by one
+        for (int w = 0; w < 3; ++w) foldedDifferences[w] = (foldedDifferences[w] >> 1) | (foldedDifferences[w + 1] << 63);
+        foldedDifferences[3] >>= 1;
+
+        Words c;
+        for (int w = 0; w < 4; ++w) c[w] = sums[w] ^ foldedSums[w] ^ differences[w] ^ foldedDifferences[w];
+        c[3] &= topMask;
+        return c;
+    }
+
+    // product of two elements in the GF2mElement::toWords order
+    static Words multiply(const Words& a, const Words& b, Kernel k = kernel()) {
+        return fromPalindromic(multiplyPalindromic(toPalindromic(a), toPalindromic(b), k));
+    }
+};
+
+#endif //LW4_GF2MPALINDROMIC_H
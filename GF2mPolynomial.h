@@ -0,0 +1,180 @@
+#ifndef LW4_GF2MPOLYNOMIAL_H
+#define LW4_GF2MPOLYNOMIAL_H
+
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <vector>
+#include "GF2mElement.h"
+
+// Polynomials over GF(2^m), coefficients from degree 0 up
+class GF2mPolynomial {
+private:
+    std::vector<GF2mElement> coefficients;
+
+    static const size_t KARATSUBA_THRESHOLD = 8;
+
+    static std::vector<GF2mElement> schoolbook(const std::vector<GF2mElement>& a, const std::vector<GF2mElement>& b) {
+        std::vector<GF2mElement> result(a.size() + b.size() - 1, GF2mElement::zero());
+        for (size_t i = 0; i < a.size(); ++i) {
+            if (a[i].isZero()) continue;
+            for (size_t j = 0; j < b.size(); ++j) {
+                if (b[j].isZero()) continue;
+                result[i + j] = result[i + j] + (b[j].isOne() ? a[i] : a[i].isOne() ? b[j] : a[i] * b[j]);
+            }
+        }
+        return result;
+    }
+
+    static void addInto(std::vector<GF2mElement>& target, const std::vector<GF2mElement>& source, size_t offset) {
+        for (size_t i = 0; i < source.size(); ++i) {
+            target[offset + i] = target[offset + i] + source[i];
+        }
+    }
+
+    static std::vector<GF2mElement> sum(const std::vector<GF2mElement>& a, const std::vector<GF2mElement>& b) {
+        std::vector<GF2mElement> result = a.size() >= b.size() ? a : b;
+        addInto(result, a.size() >= b.size() ? b : a, 0);
+        return result;
+    }
+
+    // a0 b0 + ((a0 + a1)(b0 + b1) + a0 b0 + a1 b1) x^h + a1 b1 x^2h; the three half products
+    // run on their own threads while parallelDepth > 0
+    static std::vector<GF2mElement> karatsuba(const std::vector<GF2mElement>& a, const std::vector<GF2mElement>& b,
+                                              int parallelDepth) {
+        if (a.empty() || b.empty()) return {};
+        if (std::min(a.size(), b.size()) < KARATSUBA_THRESHOLD) return schoolbook(a, b);
+
+        size_t h = std::max(a.size(), b.size()) / 2;
+        if (h >= a.size() || h >= b.size()) {
+            // very unbalanced: split only the longer operand
+            const auto& longer = a.size() >= b.size() ? a : b;
+            const auto& shorter = a.size() >= b.size() ? b : a;
+            std::vector<GF2mElement> lo(longer.begin(), longer.begin() + h), hi(longer.begin() + h, longer.end());
+            std::vector<GF2mElement> result(a.size() + b.size() - 1, GF2mElement::zero());
+            addInto(result, karatsuba(lo, shorter, parallelDepth), 0);
+            addInto(result, karatsuba(hi, shorter, parallelDepth), h);
+            return result;
+        }
+
+        std::vector<GF2mElement> a0(a.begin(), a.begin() + h), a1(a.begin() + h, a.end());
+        std::vector<GF2mElement> b0(b.begin(), b.begin() + h), b1(b.begin() + h, b.end());
+        std::vector<GF2mElement> as = sum(a0, a1), bs = sum(b0, b1);
+
+        std::vector<GF2mElement> z0, z1, z2;
+        if (parallelDepth > 0) {
+            auto f0 = std::async(std::launch::async, karatsuba, std::cref(a0), std::cref(b0), parallelDepth - 1);
+            auto f2 = std::async(std::launch::async, karatsuba, std::cref(a1), std::cref(b1), parallelDepth - 1);
+            z1 = karatsuba(as, bs, parallelDepth - 1);
+            z0 = f0.get();
+            z2 = f2.get();
+        } else {
+            z0 = karatsuba(a0, b0, 0);
+            z2 = karatsuba(a1, b1, 0);
+            z1 = karatsuba(as, bs, 0);
+        }
+        addInto(z1, z0, 0);
+        addInto(z1, z2, 0);
+
+        std::vector<GF2mElement> result(a.size() + b.size() - 1, GF2mElement::zero());
+        addInto(result, z0, 0);
+        addInto(result, z1, h);
+        addInto(result, z2, 2 * h);
+        return result;
+    }
+
+    static int depthFor(int threads) {
+        int depth = 0;
+        for (int t = 1; t < threads; t *= 3) ++depth;
+        return depth;
+    }
+
+public:
+    explicit GF2mPolynomial(const std::vector<GF2mElement>& coefficients) : coefficients(coefficients) {}
+
+    const std::vector<GF2mElement>& getCoefficients() const {
+        return coefficients;
+    }
+
+    int degree() const {
+        int d = static_cast<int>(coefficients.size()) - 1;
+        while (d >= 0 && coefficients[d].isZero()) --d;
+        return d;
+    }
+
+    GF2mPolynomial multiply(const GF2mPolynomial& other, int threads = 1) const {
+        return GF2mPolynomial(karatsuba(coefficients, other.coefficients, depthFor(threads)));
+    }
+
+    GF2mPolynomial operator*(const GF2mPolynomial& other) const {
+        return multiply(other);
+    }
+
+    GF2mElement evaluate(const GF2mElement& x) const {
+        GF2mElement result = GF2mElement::zero();
+        for (auto it = coefficients.rbegin(); it != coefficients.rend(); ++it) {
+            result = result * x + *it;
+        }
+        return result;
+    }
+
+    // prod (x + r) over the roots; the levels below the root are split across threads pair by pair,
+    // the last few products run their Karatsuba halves in parallel instead
+    static GF2mPolynomial fromRoots(const std::vector<GF2mElement>& roots, int threads = 0) {
+        if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<GF2mPolynomial> level;
+        for (const GF2mElement& r : roots) {
+            level.emplace_back(std::vector<GF2mElement>{r, GF2mElement::one()});
+        }
+        if (level.empty()) return GF2mPolynomial({GF2mElement::one()});
+
+        while (level.size() > 1) {
+            size_t pairs = level.size() / 2;
+            std::vector<GF2mPolynomial> next(pairs, GF2mPolynomial({}));
+            int depth = pairs >= static_cast<size_t>(threads) ? 0 : depthFor(threads / static_cast<int>(pairs));
+
+            std::vector<std::thread> pool;
+            size_t workers = std::min(pairs, static_cast<size_t>(threads));
+            for (size_t w = 0; w < workers; ++w) {
+                pool.emplace_back([&, w] {
+                    for (size_t i = w; i < pairs; i += workers) {
+                        next[i] = GF2mPolynomial(karatsuba(level[2 * i].coefficients, level[2 * i + 1].coefficients, depth));
+                    }
+                });
+            }
+            for (auto& th : pool) th.join();
+
+            if (level.size() % 2) next.push_back(level.back());
+            level = std::move(next);
+        }
+        return level.front();
+    }
+};
+
+// prod (x + a^(2^i)) over the distinct conjugates of a; its coefficients lie in GF(2).
+// Entry i of the result is the coefficient of x^i. False if the product tree left a coefficient outside GF(2),
+// which can only be a bug in the multiplication.
+inline bool minimalPolynomial(const GF2mElement& a, std::vector<bool>& result, int threads = 0) {
+    GF2mPolynomial product = GF2mPolynomial::fromRoots(a.conjugates(), threads);
+    result.clear();
+    for (const GF2mElement& c : product.getCoefficients()) {
+        if (!c.isZero() && !c.isOne()) return false;
+        result.push_back(c.isOne());
+    }
+    return true;
+}
+
+// the minimal polynomial of a is monic of degree |conjugates()| and vanishes at a
+inline bool checkMinimalPolynomial(const GF2mElement& a, int threads = 0) {
+    std::vector<bool> poly;
+    if (!minimalPolynomial(a, poly, threads)) return false;
+    if (poly.size() != a.conjugates().size() + 1 || !poly.back()) return false;
+    GF2mElement value = GF2mElement::zero();
+    for (size_t i = poly.size(); i-- > 0;) {
+        value = value * a;
+        if (poly[i]) value = value + GF2mElement::one();
+    }
+    return value.isZero();
+}
+
+#endif //LW4_GF2MPOLYNOMIAL_H
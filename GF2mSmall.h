@@ -0,0 +1,153 @@
+#ifndef LW4_GF2MSMALL_H
+#define LW4_GF2MSMALL_H
+
+#include <cstdint>
+#include <vector>
+#include <iostream>
+
+// GF(2^M) in a type II optimal normal basis for toy sizes (M < 64), one coordinate per bit:
+// bit k of the word is the coefficient of beta^(2^k). Same interface as GF2mElement where it matters
+// (squareONB, sqrtONB, frobenius, trace, inverse, zero, one), so curve code can be written once.
+template <int M>
+class GF2mSmall {
+    static_assert(M > 1 && M < 64, "GF2mSmall packs an element into one 64-bit word");
+
+private:
+    uint64_t bits;
+
+    static constexpr uint64_t mask = (uint64_t(1) << M) - 1;
+    static constexpr int p = 2 * M + 1;
+
+    static uint64_t rotateLeft(uint64_t x, int k) {
+        k %= M;
+        if (k == 0) return x;
+        return ((x << k) | (x >> (M - k))) & mask;
+    }
+
+    static uint64_t rotateRight(uint64_t x, int k) {
+        return rotateLeft(x, M - k % M);
+    }
+
+    // row i of the lambda matrix: beta^(2^i) * beta^(2^j) contains beta iff 2^i +- 2^j = +-1 mod p
+    static const std::vector<std::pair<int, int>>& lambdaRows() {
+        static const std::vector<std::pair<int, int>> rows = [] {
+            std::vector<int> pow2(M);
+            pow2[0] = 1;
+            for (int i = 1; i < M; ++i) pow2[i] = pow2[i - 1] * 2 % p;
+
+            std::vector<std::pair<int, int>> result(M, {-1, -1});
+            for (int i = 0; i < M; ++i) {
+                for (int j = 0; j < M; ++j) {
+                    int sum = (pow2[i] + pow2[j]) % p;
+                    int diff = (pow2[i] - pow2[j] + p) % p;
+                    bool hit = sum == 1 || sum == p - 1 || diff == 1 || diff == p - 1;
+                    if (!hit) continue;
+                    if (result[i].first < 0) result[i].first = j;
+                    else result[i].second = j;
+                }
+            }
+            return result;
+        }();
+        return rows;
+    }
+
+public:
+    GF2mSmall() : bits(0) {}
+
+    explicit GF2mSmall(uint64_t bits) : bits(bits & mask) {}
+
+    static GF2mSmall zero() {
+        return GF2mSmall(0);
+    }
+
+    static GF2mSmall one() {
+        return GF2mSmall(mask);
+    }
+
+    static int getM() {
+        return M;
+    }
+
+    uint64_t getBits() const {
+        return bits;
+    }
+
+    bool isZero() const {
+        return bits == 0;
+    }
+
+    bool isOne() const {
+        return bits == mask;
+    }
+
+    bool operator==(const GF2mSmall& other) const {
+        return bits == other.bits;
+    }
+
+    bool operator!=(const GF2mSmall& other) const {
+        return bits != other.bits;
+    }
+
+    GF2mSmall operator+(const GF2mSmall& other) const {
+        return GF2mSmall(bits ^ other.bits);
+    }
+
+    // c_k = sum_i a_(i+k) * sum_(j in row i) b_(j+k): every output bit at once, one row per step
+    GF2mSmall operator*(const GF2mSmall& other) const {
+        uint64_t rotated_b[M];
+        for (int s = 0; s < M; ++s) {
+            rotated_b[s] = rotateRight(other.bits, s);
+        }
+
+        const auto& rows = lambdaRows();
+        uint64_t result = 0;
+        for (int i = 0; i < M; ++i) {
+            uint64_t column = rotated_b[rows[i].first];
+            if (rows[i].second >= 0) column ^= rotated_b[rows[i].second];
+            result ^= rotateRight(bits, i) & column;
+        }
+        return GF2mSmall(result);
+    }
+
+    GF2mSmall squareONB() const {
+        return GF2mSmall(rotateLeft(bits, 1));
+    }
+
+    GF2mSmall sqrtONB() const {
+        return GF2mSmall(rotateRight(bits, 1));
+    }
+
+    GF2mSmall frobenius(int k) const {
+        return GF2mSmall(rotateLeft(bits, ((k % M) + M) % M));
+    }
+
+    bool trace() const {
+        return __builtin_parityll(bits);
+    }
+
+    // Itoh-Tsujii: a^-1 = (a^(2^(M-1) - 1))^2
+    GF2mSmall inverse() const {
+        GF2mSmall beta = *this;
+        int k = 1;
+        int e = M - 1;
+        int top = 63 - __builtin_clzll(static_cast<uint64_t>(e));
+        for (int i = top - 1; i >= 0; --i) {
+            beta = beta.frobenius(k) * beta;
+            k *= 2;
+            if ((e >> i) & 1) {
+                beta = beta.squareONB() * (*this);
+                ++k;
+            }
+        }
+        return beta.squareONB();
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const GF2mSmall& element) {
+        for (int i = 0; i < M; ++i) {
+            os << (((element.bits >> i) & 1) ? '1' : '0');
+        }
+        return os;
+    }
+};
+
+#endif //LW4_GF2MSMALL_H
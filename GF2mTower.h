@@ -0,0 +1,234 @@
+#ifndef LW4_GF2MTOWER_H
+#define LW4_GF2MTOWER_H
+
+#include <iostream>
+#include <vector>
+#include "GF2mElement.h"
+
+// GF(2^2m) = GF(2^m)[s] / (s^2 + s + 1), element c0 + c1*s
+class GF2m2Element {
+private:
+    GF2mElement c0;
+    GF2mElement c1;
+
+public:
+    GF2m2Element(const GF2mElement& c0, const GF2mElement& c1) : c0(c0), c1(c1) {}
+
+    explicit GF2m2Element(const GF2mElement& c0) : c0(c0), c1(GF2mElement::zero()) {}
+
+    static GF2m2Element zero() {
+        return GF2m2Element(GF2mElement::zero(), GF2mElement::zero());
+    }
+
+    static GF2m2Element one() {
+        return GF2m2Element(GF2mElement::one(), GF2mElement::zero());
+    }
+
+    const GF2mElement& getC0() const { return c0; }
+    const GF2mElement& getC1() const { return c1; }
+
+    bool isZero() const {
+        return c0.isZero() && c1.isZero();
+    }
+
+    bool isOne() const {
+        return c0.isOne() && c1.isZero();
+    }
+
+    GF2m2Element operator+(const GF2m2Element& other) const {
+        return GF2m2Element(c0 + other.c0, c1 + other.c1);
+    }
+
+    // (a0 + a1 s)(b0 + b1 s) = (a0b0 + a1b1) + ((a0 + a1)(b0 + b1) + a0b0) s
+    GF2m2Element operator*(const GF2m2Element& other) const {
+        GF2mElement v0 = c0 * other.c0;
+        GF2mElement v1 = c1 * other.c1;
+        GF2mElement v2 = (c0 + c1) * (other.c0 + other.c1);
+        return GF2m2Element(v0 + v1, v2 + v0);
+    }
+
+    GF2m2Element operator*(const GF2mElement& scalar) const {
+        return GF2m2Element(c0 * scalar, c1 * scalar);
+    }
+
+    GF2m2Element mulByS() const {
+        return GF2m2Element(c1, c0 + c1);
+    }
+
+    // (c0 + c1 s)^2 = (c0^2 + c1^2) + c1^2 s
+    GF2m2Element square() const {
+        GF2mElement s0 = c0.squareONB();
+        GF2mElement s1 = c1.squareONB();
+        return GF2m2Element(s0 + s1, s1);
+    }
+
+    // x^(2^k); s^(2^k) is s for even k and s + 1 for odd k
+    GF2m2Element frobenius(int k) const {
+        GF2mElement f0 = c0.frobenius(k);
+        GF2mElement f1 = c1.frobenius(k);
+        if (k % 2 != 0) {
+            return GF2m2Element(f0 + f1, f1);
+        }
+        return GF2m2Element(f0, f1);
+    }
+
+    // x * x^(2^m) = c0^2 + c0c1 + c1^2 lies in GF(2^m)
+    GF2mElement norm() const {
+        return c0.squareONB() + c0 * c1 + c1.squareONB();
+    }
+
+    GF2m2Element inverse() const {
+        GF2mElement n_inv = norm().inverse();
+        return GF2m2Element((c0 + c1) * n_inv, c1 * n_inv);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const GF2m2Element& element) {
+        os << element.c1 << " " << element.c0;
+        return os;
+    }
+};
+
+// GF(2^4m) = GF(2^2m)[t] / (t^2 + t + s), element c0 + c1*t
+class GF2m4Element {
+private:
+    GF2m2Element c0;
+    GF2m2Element c1;
+
+public:
+    GF2m4Element(const GF2m2Element& c0, const GF2m2Element& c1) : c0(c0), c1(c1) {}
+
+    explicit GF2m4Element(const GF2m2Element& c0) : c0(c0), c1(GF2m2Element::zero()) {}
+
+    explicit GF2m4Element(const GF2mElement& c0) : c0(c0), c1(GF2m2Element::zero()) {}
+
+    static GF2m4Element zero() {
+        return GF2m4Element(GF2m2Element::zero(), GF2m2Element::zero());
+    }
+
+    static GF2m4Element one() {
+        return GF2m4Element(GF2m2Element::one(), GF2m2Element::zero());
+    }
+
+    const GF2m2Element& getC0() const { return c0; }
+    const GF2m2Element& getC1() const { return c1; }
+
+    bool isZero() const {
+        return c0.isZero() && c1.isZero();
+    }
+
+    bool isOne() const {
+        return c0.isOne() && c1.isZero();
+    }
+
+    GF2m4Element operator+(const GF2m4Element& other) const {
+        return GF2m4Element(c0 + other.c0, c1 + other.c1);
+    }
+
+    // (A0 + A1 t)(B0 + B1 t) = (A0B0 + A1B1 s) + ((A0 + A1)(B0 + B1) + A0B0) t
+    GF2m4Element operator*(const GF2m4Element& other) const {
+        GF2m2Element v0 = c0 * other.c0;
+        GF2m2Element v1 = c1 * other.c1;
+        GF2m2Element v2 = (c0 + c1) * (other.c0 + other.c1);
+        return GF2m4Element(v0 + v1.mulByS(), v2 + v0);
+    }
+
+    GF2m4Element operator*(const GF2m2Element& scalar) const {
+        return GF2m4Element(c0 * scalar, c1 * scalar);
+    }
+
+    GF2m4Element operator*(const GF2mElement& scalar) const {
+        return GF2m4Element(c0 * scalar, c1 * scalar);
+    }
+
+    // multiplication by g0 + g1 s + t, the shape of every eta_T line function
+    GF2m4Element mulByLine(const GF2m2Element& g) const {
+        GF2m2Element v0 = c0 * g;
+        GF2m2Element v1 = c1 * g;
+        return GF2m4Element(v0 + c1.mulByS(), v1 + c0 + c1);
+    }
+
+    // (A0 + A1 t)^2 = (A0^2 + A1^2 s) + A1^2 t
+    GF2m4Element square() const {
+        GF2m2Element s0 = c0.square();
+        GF2m2Element s1 = c1.square();
+        return GF2m4Element(s0 + s1.mulByS(), s1);
+    }
+
+    // x^(2^k); t^(2^k) cycles through t, t + s, t + 1, t + s + 1
+    GF2m4Element frobenius(int k) const {
+        GF2m2Element f0 = c0.frobenius(k);
+        GF2m2Element f1 = c1.frobenius(k);
+        switch (((k % 4) + 4) % 4) {
+            case 1: return GF2m4Element(f0 + f1.mulByS(), f1);
+            case 2: return GF2m4Element(f0 + f1, f1);
+            case 3: return GF2m4Element(f0 + f1.mulByS() + f1, f1);
+            default: return GF2m4Element(f0, f1);
+        }
+    }
+
+    // x^(2^2m) = (c0 + c1) + c1 t
+    GF2m4Element conjugate() const {
+        return GF2m4Element(c0 + c1, c1);
+    }
+
+    // x * x^(2^2m) = c0(c0 + c1) + c1^2 s lies in GF(2^2m)
+    GF2m2Element norm() const {
+        return c0 * (c0 + c1) + c1.square().mulByS();
+    }
+
+    // norm all the way down to GF(2^m): one base inversion per element
+    GF2mElement normToBase() const {
+        return norm().norm();
+    }
+
+    GF2m4Element inverse() const {
+        GF2m2Element n_inv = norm().inverse();
+        return GF2m4Element((c0 + c1) * n_inv, c1 * n_inv);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const GF2m4Element& element) {
+        os << element.c1 << " " << element.c0;
+        return os;
+    }
+};
+
+// Montgomery's trick: n inversions for 3(n - 1) multiplications and a single inverse().
+// Zero entries are left as zero.
+template <typename Element>
+void batchInverse(std::vector<Element>& elements) {
+    ArenaVector<Element> prefix;
+    prefix.reserve(elements.size());
+    bool any_nonzero = false;
+    for (const Element& e : elements) {
+        Element previous = prefix.empty() ? Element::one() : prefix.back();
+        if (e.isZero()) {
+            prefix.push_back(previous);
+        } else {
+            prefix.push_back(previous * e);
+            any_nonzero = true;
+        }
+    }
+    if (!any_nonzero) return;
+
+    Element acc = prefix.back().inverse();
+    for (size_t i = elements.size(); i-- > 0;) {
+        if (elements[i].isZero()) continue;
+        Element inv = (i == 0) ? acc : acc * prefix[i - 1];
+        acc = acc * elements[i];
+        elements[i] = inv;
+    }
+}
+
+// result[i] = a[i] * b[i]; false, with result left empty, if a and b differ in length
+template <typename Element>
+bool batchMultiply(const std::vector<Element>& a, const std::vector<Element>& b, std::vector<Element>& result) {
+    result.clear();
+    if (a.size() != b.size()) return false;
+    result.reserve(a.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        result.push_back(a[i] * b[i]);
+    }
+    return true;
+}
+
+#endif //LW4_GF2MTOWER_H
@@ -0,0 +1,76 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include "GabidulinCode.h"
+
+static GF2mElement randomElement(std::mt19937_64& rng) {
+    return GF2mElement::fromWords({rng(), rng(), rng(), rng()});
+}
+
+// rank-r error: e_i = sum_l b_il eps_l with random eps_l in GF(2^m) and random bits b_il
+static std::vector<GF2mElement> randomRankError(int n, int r, std::mt19937_64& rng) {
+    std::vector<GF2mElement> span;
+    for (int l = 0; l < r; ++l) span.push_back(randomElement(rng));
+    std::vector<GF2mElement> error(n, GF2mElement::zero());
+    for (int i = 0; i < n; ++i) {
+        for (int l = 0; l < r; ++l) {
+            if (rng() & 1) error[i] = error[i] + span[l];
+        }
+    }
+    return error;
+}
+
+// usage: Gabidulin [n] [k] [words] [threads]
+int main(int argc, char* argv[]) {
+    int n = argc > 1 ? std::atoi(argv[1]) : 16;
+    int k = argc > 2 ? std::atoi(argv[2]) : 8;
+    int words = argc > 3 ? std::atoi(argv[3]) : 2;
+    int threads = argc > 4 ? std::atoi(argv[4]) : static_cast<int>(std::thread::hardware_concurrency());
+
+    if (words < 0 || threads < 0) {
+        std::cerr << "words and threads must not be negative" << std::endl;
+        return 1;
+    }
+    GabidulinCode code(n, k);
+    if (!code.isValid()) {
+        std::cerr << "need 0 < k <= n <= " << GF2mElement::getM() << ", got n = " << n << ", k = " << k << std::endl;
+        return 1;
+    }
+    std::cout << "Gabidulin code [" << code.getN() << ", " << code.getK() << "], corrects rank " << code.getT()
+              << " errors" << std::endl;
+
+    std::mt19937_64 rng(2024);
+    std::vector<std::vector<GF2mElement>> messages(words);
+    for (auto& msg : messages) {
+        for (int j = 0; j < code.getK(); ++j) msg.push_back(randomElement(rng));
+    }
+
+    auto start_enc = std::chrono::high_resolution_clock::now();
+    auto codewords = code.batchEncode(messages, threads);
+    auto stop_enc = std::chrono::high_resolution_clock::now();
+    double seconds_enc = std::chrono::duration<double>(stop_enc - start_enc).count();
+    std::cout << "Encode: " << words / seconds_enc << " codewords/s" << std::endl;
+
+    for (auto& c : codewords) {
+        auto e = randomRankError(code.getN(), code.getT(), rng);
+        for (int i = 0; i < code.getN(); ++i) c[i] = c[i] + e[i];
+    }
+
+    std::vector<bool> ok;
+    auto start_dec = std::chrono::high_resolution_clock::now();
+    auto decoded = code.batchDecode(codewords, ok, threads);
+    auto stop_dec = std::chrono::high_resolution_clock::now();
+    double seconds_dec = std::chrono::duration<double>(stop_dec - start_dec).count();
+
+    int correct = 0;
+    for (int w = 0; w < words; ++w) {
+        bool same = ok[w];
+        for (int j = 0; same && j < code.getK(); ++j) same = (decoded[w][j] + messages[w][j]).isZero();
+        correct += same;
+    }
+    std::cout << "Decode: " << words / seconds_dec << " codewords/s, " << correct << "/" << words
+              << " corrected" << std::endl;
+    return correct == words ? 0 : 1;
+}
@@ -0,0 +1,212 @@
+#ifndef LW4_GABIDULINCODE_H
+#define LW4_GABIDULINCODE_H
+
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <vector>
+#include "GF2mElement.h"
+
+// Gabidulin code of length n <= m and dimension k over GF(2^m). The evaluation points are the
+// normal basis elements g_i = beta^(2^i), so every g_i^(2^j) = beta^(2^(i+j)) is another basis element
+// and each product with one is the sparse multiplyByBasisElement instead of a full multiplication.
+// Decoding is Loidreau's Welch-Berlekamp reconstruction in O(n (k + t)) multiplications: two pairs of
+// q-polynomials (V, N) take in the points one at a time, keeping V(y_i) = N(g_i) for every point so far. The pair
+// of lower weighted degree absorbs a point by composition with x^2 + delta x on the left and the other is
+// corrected by a multiple of it; then f = V \ N. A code needs 0 < k <= n <= m; isValid() is false otherwise
+// and such a code decodes nothing.
+class GabidulinCode {
+private:
+    int n;
+    int k;
+    int t;
+
+    // sum_j f_j g_i^(2^j)
+    GF2mElement evaluateAtPoint(const std::vector<GF2mElement>& f, int i) const {
+        GF2mElement result = GF2mElement::zero();
+        for (size_t j = 0; j < f.size(); ++j) {
+            if (f[j].isZero()) continue;
+            result = result + f[j].multiplyByBasisElement((i + static_cast<int>(j)) % GF2mElement::getM());
+        }
+        return result;
+    }
+
+    // q-polynomials sum_j c_j x^(2^j), c_j for j = 0, 1, ...
+    struct Pair {
+        std::vector<GF2mElement> V;
+        std::vector<GF2mElement> N;
+    };
+
+    static int degree(const std::vector<GF2mElement>& p) {
+        int d = static_cast<int>(p.size()) - 1;
+        while (d >= 0 && p[d].isZero()) --d;
+        return d;
+    }
+
+    // N may exceed V by k - 1 in q-degree, so V is weighted by k - 1
+    int weightedDegree(const Pair& pair) const {
+        int dV = degree(pair.V), dN = degree(pair.N);
+        return std::max(dV < 0 ? -1 : dV + k - 1, dN);
+    }
+
+    // V(y_i) + N(g_i), zero once the pair interpolates point i
+    GF2mElement discrepancy(const Pair& pair, const GF2mElement& y, int i) const {
+        GF2mElement sum = evaluateAtPoint(pair.N, i);
+        for (size_t j = 0; j < pair.V.size(); ++j) {
+            if (!pair.V[j].isZero()) sum = sum + pair.V[j] * y.frobenius(static_cast<int>(j));
+        }
+        return sum;
+    }
+
+    // target = c target + d p
+    static void combine(std::vector<GF2mElement>& target, const GF2mElement& c, const std::vector<GF2mElement>& p,
+                        const GF2mElement& d) {
+        if (target.size() < p.size()) target.resize(p.size(), GF2mElement::zero());
+        for (size_t j = 0; j < target.size(); ++j) {
+            if (!target[j].isZero()) target[j] = target[j] * c;
+            if (j < p.size() && !p[j].isZero()) target[j] = target[j] + p[j] * d;
+        }
+    }
+
+    // (x^2 + delta x) o p: vanishes again on every point p already vanished on, and now on the one where p was delta
+    static void raise(std::vector<GF2mElement>& p, const GF2mElement& delta) {
+        std::vector<GF2mElement> result(p.size() + 1, GF2mElement::zero());
+        for (size_t j = 0; j < p.size(); ++j) {
+            if (p[j].isZero()) continue;
+            result[j + 1] = result[j + 1] + p[j].squareONB();
+            result[j] = result[j] + p[j] * delta;
+        }
+        p = std::move(result);
+    }
+
+    // f with N = V o f, accepted if f has fewer than k coefficients and its codeword is within rank t
+    bool divide(const Pair& pair, const std::vector<GF2mElement>& received, std::vector<GF2mElement>& message) const {
+        std::vector<GF2mElement> V = pair.V, N = pair.N;
+        int dV = degree(V);
+        if (dV < 0 || dV > t) return false;
+        // left division, top coefficient first: v_d f_i^(2^d) = N_(i+d)
+        GF2mElement leadInv = V[dV].inverse();
+        std::vector<GF2mElement> f(k, GF2mElement::zero());
+        for (int s = degree(N); s >= dV; --s) {
+            if (N[s].isZero()) continue;
+            int i = s - dV;
+            if (i >= k) return false;
+            f[i] = (N[s] * leadInv).frobenius(-dV);
+            for (int j = 0; j <= dV; ++j) {
+                if (!V[j].isZero()) N[i + j] = N[i + j] + V[j] * f[i].frobenius(j);
+            }
+        }
+        for (int s = 0; s < dV && s < static_cast<int>(N.size()); ++s) {
+            if (!N[s].isZero()) return false;
+        }
+
+        std::vector<GF2mElement> error = encode(f);
+        for (int i = 0; i < n; ++i) error[i] = error[i] + received[i];
+        if (rank(error) > t) return false;
+
+        message = f;
+        return true;
+    }
+
+    template <typename Job>
+    static void runBatch(size_t count, int threads, Job job) {
+        if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<std::thread> pool;
+        for (int w = 0; w < threads && static_cast<size_t>(w) < count; ++w) {
+            pool.emplace_back([&, w] {
+                for (size_t i = w; i < count; i += threads) job(i);
+            });
+        }
+        for (auto& th : pool) th.join();
+    }
+
+public:
+    GabidulinCode(int n, int k) : n(n), k(k), t(isValid() ? (n - k) / 2 : 0) {}
+
+    bool isValid() const { return 0 < k && k <= n && n <= GF2mElement::getM(); }
+
+    int getN() const { return n; }
+    int getK() const { return k; }
+    int getT() const { return t; }
+
+    // c_i = f(g_i) for the linearized message polynomial f = sum message_j x^(2^j)
+    std::vector<GF2mElement> encode(const std::vector<GF2mElement>& message) const {
+        std::vector<GF2mElement> codeword;
+        codeword.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            codeword.push_back(evaluateAtPoint(message, i));
+        }
+        return codeword;
+    }
+
+    // rank over GF(2) of the n x m binary matrix formed by the coordinates of the entries
+    static int rank(const std::vector<GF2mElement>& vector) {
+        std::vector<std::array<uint64_t, 4>> rows;
+        for (const GF2mElement& e : vector) rows.push_back(e.toWords());
+        int r = 0;
+        for (int bit = 0; bit < GF2mElement::getM() && r < static_cast<int>(rows.size()); ++bit) {
+            int w = bit / 64;
+            uint64_t b = uint64_t(1) << (bit % 64);
+            size_t pivot = r;
+            while (pivot < rows.size() && !(rows[pivot][w] & b)) ++pivot;
+            if (pivot == rows.size()) continue;
+            std::swap(rows[pivot], rows[r]);
+            for (size_t i = r + 1; i < rows.size(); ++i) {
+                if (rows[i][w] & b) {
+                    for (int j = 0; j < 4; ++j) rows[i][j] ^= rows[r][j];
+                }
+            }
+            ++r;
+        }
+        return r;
+    }
+
+    // recovers the message if the error has rank at most t; false for a received word that is not n long
+    bool decode(const std::vector<GF2mElement>& received, std::vector<GF2mElement>& message) const {
+        if (!isValid() || received.size() != static_cast<size_t>(n)) return false;
+
+        // pair 0 starts at (V, N) = (0, x), pair 1 at (x, 0)
+        Pair pairs[2];
+        pairs[0].N = {GF2mElement::one()};
+        pairs[1].V = {GF2mElement::one()};
+        for (int i = 0; i < n; ++i) {
+            GF2mElement delta[2] = {discrepancy(pairs[0], received[i], i), discrepancy(pairs[1], received[i], i)};
+            if (delta[0].isZero() && delta[1].isZero()) continue;
+            // the pair of smaller weighted degree among those the point rejects absorbs the point
+            int a = delta[0].isZero() ? 1 : delta[1].isZero() ? 0 : weightedDegree(pairs[0]) <= weightedDegree(pairs[1]) ? 0 : 1;
+            int b = 1 - a;
+            // delta_a P_b + delta_b P_a rather than a division: an inversion costs dozens of multiplications
+            if (!delta[b].isZero()) {
+                combine(pairs[b].V, delta[a], pairs[a].V, delta[b]);
+                combine(pairs[b].N, delta[a], pairs[a].N, delta[b]);
+            }
+            raise(pairs[a].V, delta[a]);
+            raise(pairs[a].N, delta[a]);
+        }
+
+        int first = weightedDegree(pairs[0]) <= weightedDegree(pairs[1]) ? 0 : 1;
+        for (int p : {first, 1 - first}) {
+            if (divide(pairs[p], received, message)) return true;
+        }
+        return false;
+    }
+
+    std::vector<std::vector<GF2mElement>> batchEncode(const std::vector<std::vector<GF2mElement>>& messages,
+                                                      int threads = 0) const {
+        std::vector<std::vector<GF2mElement>> codewords(messages.size());
+        runBatch(messages.size(), threads, [&](size_t i) { codewords[i] = encode(messages[i]); });
+        return codewords;
+    }
+
+    // ok[i] tells whether received[i] decoded
+    std::vector<std::vector<GF2mElement>> batchDecode(const std::vector<std::vector<GF2mElement>>& received,
+                                                      std::vector<bool>& ok, int threads = 0) const {
+        std::vector<std::vector<GF2mElement>> messages(received.size());
+        std::vector<char> flags(received.size(), 0);
+        runBatch(received.size(), threads, [&](size_t i) { flags[i] = decode(received[i], messages[i]); });
+        ok.assign(flags.begin(), flags.end());
+        return messages;
+    }
+};
+
+#endif //LW4_GABIDULINCODE_H
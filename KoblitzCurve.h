@@ -0,0 +1,272 @@
+#ifndef LW4_KOBLITZCURVE_H
+#define LW4_KOBLITZCURVE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Arena.h"
+#include "BigInt.h"
+#include "BinaryCurve.h"
+#include "ForkJoinGroup.h"
+
+// r0 + r1 tau in Z[tau]
+struct TauElement {
+    BigInt r0;
+    BigInt r1;
+};
+
+// Koblitz curve y^2 + xy = x^3 + a x^2 + 1 with scalars recoded in base tau, the Frobenius endomorphism
+// (x, y) -> (x^2, y^2) with tau^2 = mu tau - 2, mu = (-1)^(1 - a). A Frobenius step is a rotation of both
+// normal-basis coordinates, so a tau-adic Horner loop only pays for its additions.
+//
+// Scalars are first partially reduced modulo delta = (tau^m - 1) / (tau - 1) (Solinas), which acts as zero
+// on the subgroup of order n = N(delta); multiply and doubleMultiply therefore expect points of order n.
+template <typename Field>
+class KoblitzCurve {
+public:
+    // alpha_u G for the odd u < 2^(width - 1), alpha_u = u mods tau^width
+    struct FixedBaseTable {
+        int width;
+        std::vector<BinaryPoint<Field>> points;
+    };
+
+private:
+    BinaryCurve<Field> curve;
+    int mu;
+    TauElement delta;
+    BigInt order; // N(delta)
+
+    static TauElement multiplyElements(const TauElement& x, const TauElement& y, int mu) {
+        BigInt top = x.r1 * y.r1;
+        BigInt r1 = x.r0 * y.r1 + x.r1 * y.r0;
+        return TauElement{x.r0 * y.r0 - top - top, mu > 0 ? r1 + top : r1 - top};
+    }
+
+    static BigInt norm(const TauElement& x, int mu) {
+        BigInt cross = x.r0 * x.r1;
+        BigInt square = x.r1 * x.r1;
+        return x.r0 * x.r0 + (mu > 0 ? cross : -cross) + square + square;
+    }
+
+    // (r0 + r1 tau) / tau = r1 + mu r0 / 2 - (r0 / 2) tau for even r0
+    static TauElement divideByTau(const TauElement& x, int mu) {
+        BigInt h = x.r0.half();
+        return TauElement{mu > 0 ? x.r1 + h : x.r1 - h, -h};
+    }
+
+    // U_i of tau^i = U_i tau - 2 U_(i-1)
+    static std::vector<int64_t> lucas(int count, int mu) {
+        std::vector<int64_t> U{0, 1};
+        while (static_cast<int>(U.size()) <= count) U.push_back(mu * U.back() - 2 * U[U.size() - 2]);
+        return U;
+    }
+
+    // tau = t_w mod tau^w, i.e. t_w = 2 U_(w-1) / U_w mod 2^w
+    static uint64_t tauResidue(int width, int mu) {
+        std::vector<int64_t> U = lucas(width, mu);
+        uint64_t mask = (uint64_t(1) << width) - 1;
+        uint64_t odd = static_cast<uint64_t>(U[width]) & mask, inverse = 1;
+        for (int i = 0; i < 6; ++i) inverse *= 2 - odd * inverse; // Newton: inverse mod 2^64 of an odd number
+        return (2 * static_cast<uint64_t>(U[width - 1]) * inverse) & mask;
+    }
+
+    // u - round(u / tau^w) tau^w as (beta, gamma) with alpha_u = beta + gamma tau, for odd u < 2^(w - 1)
+    static std::vector<std::pair<int64_t, int64_t>> representatives(int width, int mu) {
+        std::vector<int64_t> U = lucas(width, mu);
+        TauElement power{BigInt(-2 * U[width - 1]), BigInt(U[width])};
+        BigInt modulus(int64_t(1) << width);
+        std::vector<std::pair<int64_t, int64_t>> alphas;
+        for (int64_t u = 1; u < (int64_t(1) << (width - 1)); u += 2) {
+            // u / tau^w = u conj(tau^w) / N(tau^w), conj(x0 + x1 tau) = x0 + mu x1 - x1 tau
+            BigInt lambda0 = BigInt(u) * (power.r0 + BigInt(mu) * power.r1);
+            BigInt lambda1 = -(BigInt(u) * power.r1);
+            TauElement q{BigInt::roundedQuotient(lambda0, modulus), BigInt::roundedQuotient(lambda1, modulus)};
+            TauElement qPower = multiplyElements(q, power, mu);
+            alphas.emplace_back((BigInt(u) - qPower.r0).toInt64(), (-qPower.r1).toInt64());
+        }
+        return alphas;
+    }
+
+    // beta P + gamma tau(P)
+    BinaryPoint<Field> combine(const BinaryPoint<Field>& P, int64_t beta, int64_t gamma) const {
+        BinaryPoint<Field> B = curve.multiply(P, static_cast<uint64_t>(beta < 0 ? -beta : beta));
+        BinaryPoint<Field> C = curve.multiply(curve.frobenius(P), static_cast<uint64_t>(gamma < 0 ? -gamma : gamma));
+        return curve.add(beta < 0 ? curve.negate(B) : B, gamma < 0 ? curve.negate(C) : C);
+    }
+
+    // u P for the signed digit u from the odd multiples table
+    BinaryPoint<Field> digitPoint(const std::vector<BinaryPoint<Field>>& table, int u) const {
+        const BinaryPoint<Field>& T = table[(u < 0 ? -u : u) / 2];
+        return u < 0 ? curve.negate(T) : T;
+    }
+
+public:
+    explicit KoblitzCurve(int a) : curve(BinaryCurve<Field>::koblitz(a)), mu(a ? 1 : -1) {
+        // delta = 1 + tau + ... + tau^(m - 1)
+        TauElement power{BigInt(1), BigInt(0)};
+        delta = power;
+        for (int i = 1; i < Field::getM(); ++i) {
+            power = TauElement{-(power.r1 + power.r1), mu > 0 ? power.r0 + power.r1 : power.r0 - power.r1};
+            delta = TauElement{delta.r0 + power.r0, delta.r1 + power.r1};
+        }
+        order = norm(delta, mu);
+    }
+
+    const BinaryCurve<Field>& getCurve() const { return curve; }
+    int getMu() const { return mu; }
+
+    // the prime n with #E = h n, h = 4 (a = 0) or 2 (a = 1)
+    const BigInt& getOrder() const { return order; }
+
+    // rho = k - round(k / delta) delta, with N(rho) <= N(delta), so its expansion has about m digits
+    TauElement reduce(const std::string& scalar) const {
+        BigInt k = BigInt::fromBinary(scalar);
+        BigInt lambda0 = k * (mu > 0 ? delta.r0 + delta.r1 : delta.r0 - delta.r1);
+        BigInt lambda1 = -(k * delta.r1);
+        TauElement q{BigInt::roundedQuotient(lambda0, order), BigInt::roundedQuotient(lambda1, order)};
+        TauElement qDelta = multiplyElements(q, delta, mu);
+        return TauElement{k - qDelta.r0, -qDelta.r1};
+    }
+
+    // width-w tau-adic NAF, least significant digit first: odd digits |u| < 2^(w - 1), and every nonzero digit
+    // followed by at least w - 1 zeros. Digit u stands for alpha_u (see FixedBaseTable).
+    std::vector<int> tnaf(TauElement r, int width = 2) const {
+        uint64_t t = tauResidue(width, mu);
+        auto alphas = representatives(width, mu);
+        uint64_t modulus = uint64_t(1) << width;
+        std::vector<int> digits;
+        while (!r.r0.isZero() || !r.r1.isZero()) {
+            int u = 0;
+            if (r.r0.isOdd()) {
+                uint64_t residue = (r.r0.lowBits(width) + r.r1.lowBits(width) * t) & (modulus - 1);
+                u = residue >= modulus / 2 ? static_cast<int>(residue) - static_cast<int>(modulus) : static_cast<int>(residue);
+                const auto& [beta, gamma] = alphas[(u < 0 ? -u : u) / 2];
+                r.r0 = u < 0 ? r.r0 + BigInt(beta) : r.r0 - BigInt(beta);
+                r.r1 = u < 0 ? r.r1 + BigInt(gamma) : r.r1 - BigInt(gamma);
+            }
+            digits.push_back(u);
+            r = divideByTau(r, mu);
+        }
+        return digits;
+    }
+
+    // tau-adic joint sparse form of (r, s), least significant column first. Solinas' JSF rule carries over
+    // through Z[tau] / tau^3 = Z / 8 (tau -> t_3): a digit is flipped when that makes the next digit of its
+    // row nonzero exactly where the other row's next digit is nonzero, so the nonzero columns line up.
+    std::vector<std::pair<int, int>> jointSparseForm(TauElement r, TauElement s) const {
+        uint64_t t = tauResidue(3, mu);
+        std::vector<std::pair<int, int>> columns;
+        while (!r.r0.isZero() || !r.r1.isZero() || !s.r0.isZero() || !s.r1.isZero()) {
+            uint64_t v[2] = {(r.r0.lowBits(3) + r.r1.lowBits(3) * t) & 7, (s.r0.lowBits(3) + s.r1.lowBits(3) * t) & 7};
+            int u[2] = {0, 0};
+            for (int i = 0; i < 2; ++i) {
+                if (!(v[i] & 1)) continue;
+                u[i] = (v[i] & 3) == 1 ? 1 : -1;
+                if ((v[i] == 3 || v[i] == 5) && (v[1 - i] & 3) == 2) u[i] = -u[i];
+            }
+            r.r0 = r.r0 - BigInt(u[0]);
+            s.r0 = s.r0 - BigInt(u[1]);
+            columns.emplace_back(u[0], u[1]);
+            r = divideByTau(r, mu);
+            s = divideByTau(s, mu);
+        }
+        return columns;
+    }
+
+    FixedBaseTable precompute(const BinaryPoint<Field>& G, int width = 6) const {
+        FixedBaseTable table{width, {}};
+        for (const auto& [beta, gamma] : representatives(width, mu)) table.points.push_back(combine(G, beta, gamma));
+        return table;
+    }
+
+    // scalar * P by a width-w tau-adic NAF, most significant bit first as in BinaryCurve::multiply
+    BinaryPoint<Field> multiply(const BinaryPoint<Field>& P, const std::string& scalar, int width = 4) const {
+        return Arena::run([&] {
+            FixedBaseTable table = precompute(P, width);
+            std::vector<int> digits = tnaf(reduce(scalar), width);
+            BinaryPoint<Field> result;
+            for (size_t i = digits.size(); i-- > 0;) {
+                result = curve.frobenius(result);
+                if (digits[i]) result = curve.add(result, digitPoint(table.points, digits[i]));
+            }
+            return result;
+        });
+    }
+
+    // scalar * P on all threads of the group: the tau-adic expansion is cut into one run of L digits per thread,
+    // and run j, evaluated at P, is moved up by tau^(j L). That shift is a rotation, so unlike the 2^L split of
+    // BinaryCurve::multiplyParallel nothing depends on P being fixed. The table entries are spread over the
+    // workers while the caller recodes the scalar.
+    BinaryPoint<Field> multiplyParallel(const BinaryPoint<Field>& P, const std::string& scalar, ForkJoinGroup& group,
+                                        int width = 4) const {
+        const int threads = group.getSize();
+        auto alphas = representatives(width, mu);
+        std::vector<BinaryPoint<Field>> table(alphas.size());
+        std::vector<int> digits;
+        group.run([&](int index) {
+            if (index == 0) digits = tnaf(reduce(scalar), width);
+            for (size_t u = 0; u < alphas.size(); ++u) {
+                if (static_cast<int>((u + 1) % threads) == index) table[u] = combine(P, alphas[u].first, alphas[u].second);
+            }
+        });
+
+        size_t length = (digits.size() + threads - 1) / threads;
+        std::vector<BinaryPoint<Field>> partial(threads);
+        group.run([&](int index) {
+            size_t from = std::min(digits.size(), index * length);
+            size_t to = std::min(digits.size(), from + length);
+            BinaryPoint<Field> result;
+            for (size_t i = to; i-- > from;) {
+                result = curve.frobenius(result);
+                if (digits[i]) result = curve.add(result, digitPoint(table, digits[i]));
+            }
+            partial[index] = curve.frobenius(result, static_cast<int>(from % Field::getM()));
+        });
+        BinaryPoint<Field> result;
+        for (const auto& R : partial) result = curve.add(result, R);
+        return result;
+    }
+
+    // u1 G + u2 Q from the joint sparse form of (u1, u2): one Horner loop over the columns, with the four
+    // points +-G, +-Q, +-(G + Q), +-(G - Q) covering every nonzero column in one addition
+    BinaryPoint<Field> doubleMultiply(const std::string& u1, const BinaryPoint<Field>& G,
+                                      const std::string& u2, const BinaryPoint<Field>& Q) const {
+        return Arena::run([&] {
+            BinaryPoint<Field> sum = curve.add(G, Q);
+            BinaryPoint<Field> difference = curve.add(G, curve.negate(Q));
+            std::vector<std::pair<int, int>> columns = jointSparseForm(reduce(u1), reduce(u2));
+            BinaryPoint<Field> result;
+            for (size_t i = columns.size(); i-- > 0;) {
+                result = curve.frobenius(result);
+                auto [g, q] = columns[i];
+                if (!g && !q) continue;
+                BinaryPoint<Field> T = !q ? G : !g ? Q : g == q ? sum : difference;
+                bool negated = g ? g < 0 : q < 0;
+                result = curve.add(result, negated ? curve.negate(T) : T);
+            }
+            return result;
+        });
+    }
+
+    // u1 G + u2 Q with the fixed-base table of G: the width-w expansion of u1 against the table, interleaved
+    // with a width-4 expansion of u2, both sharing the same Frobenius steps
+    BinaryPoint<Field> doubleMultiply(const std::string& u1, const FixedBaseTable& G,
+                                      const std::string& u2, const BinaryPoint<Field>& Q) const {
+        return Arena::run([&] {
+            FixedBaseTable table = precompute(Q, 4);
+            std::vector<int> g = tnaf(reduce(u1), G.width);
+            std::vector<int> q = tnaf(reduce(u2), table.width);
+            BinaryPoint<Field> result;
+            for (size_t i = std::max(g.size(), q.size()); i-- > 0;) {
+                result = curve.frobenius(result);
+                if (i < g.size() && g[i]) result = curve.add(result, digitPoint(G.points, g[i]));
+                if (i < q.size() && q[i]) result = curve.add(result, digitPoint(table.points, q[i]));
+            }
+            return result;
+        });
+    }
+};
+
+#endif //LW4_KOBLITZCURVE_H
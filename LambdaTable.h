@@ -0,0 +1,87 @@
+#ifndef LW4_LAMBDATABLE_H
+#define LW4_LAMBDATABLE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Multiplication table of a normal basis {beta^(2^i)} of GF(2^m): the positions (i, j) with lambda_ij = 1,
+// where lambda_ij is the coefficient of beta in beta^(2^i) * beta^(2^j) (the same layout as
+// GF2mElement::createMultiplicativeMatrix). Coefficient k of a product is a * lambda^(k) * b^T with
+// lambda^(k) the table shifted by k on both indices, so the number of ones C_N is the multiplier cost.
+//
+// GF2mDoubled::offsets turns a table for m = 233 into the word-parallel multiplier; the netlist generator reads
+// any m. File layout, little-endian uint32: "LW4L", version, m, type, count, then count (i, j) pairs.
+// type is the Gaussian period type T (1 and 2 are the optimal normal bases), 0 for a basis found by search.
+struct LambdaTable {
+    int m = 0;
+    int type = 0;
+    std::vector<std::pair<int, int>> ones;
+
+    static const uint32_t MAGIC = 0x4c34574c; // "LW4L"
+    static const uint32_t VERSION = 1;
+
+    int complexity() const {
+        return static_cast<int>(ones.size());
+    }
+
+    bool save(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) return false;
+        auto put = [&out](uint32_t value) {
+            unsigned char bytes[4] = {static_cast<unsigned char>(value), static_cast<unsigned char>(value >> 8),
+                                      static_cast<unsigned char>(value >> 16), static_cast<unsigned char>(value >> 24)};
+            out.write(reinterpret_cast<const char*>(bytes), 4);
+        };
+        put(MAGIC);
+        put(VERSION);
+        put(m);
+        put(type);
+        put(static_cast<uint32_t>(ones.size()));
+        for (const auto& [i, j] : ones) {
+            put(i);
+            put(j);
+        }
+        return static_cast<bool>(out);
+    }
+
+    // false if the file is missing, truncated or not a table
+    static bool load(const std::string& path, LambdaTable& table) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return false;
+        auto get = [&in](uint32_t& value) {
+            unsigned char bytes[4];
+            if (!in.read(reinterpret_cast<char*>(bytes), 4)) return false;
+            value = bytes[0] | (uint32_t(bytes[1]) << 8) | (uint32_t(bytes[2]) << 16) | (uint32_t(bytes[3]) << 24);
+            return true;
+        };
+        uint32_t magic, version, m, type, count;
+        if (!get(magic) || !get(version) || !get(m) || !get(type) || !get(count)) return false;
+        if (magic != MAGIC || version != VERSION || m == 0 || count > uint64_t(m) * m) return false;
+
+        LambdaTable result;
+        result.m = static_cast<int>(m);
+        result.type = static_cast<int>(type);
+        result.ones.reserve(count);
+        for (uint32_t c = 0; c < count; ++c) {
+            uint32_t i, j;
+            if (!get(i) || !get(j) || i >= m || j >= m) return false;
+            result.ones.emplace_back(i, j);
+        }
+        table = std::move(result);
+        return true;
+    }
+
+    // lambda as m rows of the columns j holding a one; what the bit-serial multipliers iterate over
+    std::vector<std::vector<int>> rows() const {
+        std::vector<std::vector<int>> result(m);
+        for (const auto& [i, j] : ones) result[i].push_back(j);
+        for (auto& row : result) std::sort(row.begin(), row.end());
+        return result;
+    }
+};
+
+#endif //LW4_LAMBDATABLE_H
@@ -0,0 +1,181 @@
+#ifndef LW4_LINEARIZEDPOLYNOMIAL_H
+#define LW4_LINEARIZEDPOLYNOMIAL_H
+
+#include <algorithm>
+#include <array>
+#include <thread>
+#include <vector>
+#include "GF2mElement.h"
+
+// L(x) = sum c_i x^(2^i), i < m. Every x^(2^i) is a rotation, so evaluation is a sum of products
+// with rotated operands, and L is a GF(2)-linear map of GF(2^m) that can be inverted by elimination.
+class LinearizedPolynomial {
+private:
+    std::vector<GF2mElement> coefficients;
+
+public:
+    explicit LinearizedPolynomial(const std::vector<GF2mElement>& coefficients) : coefficients(coefficients) {
+        if (this->coefficients.size() > static_cast<size_t>(GF2mElement::getM())) {
+            // x^(2^m) = x, so higher terms fold back onto lower ones
+            for (size_t i = GF2mElement::getM(); i < this->coefficients.size(); ++i) {
+                this->coefficients[i % GF2mElement::getM()] = this->coefficients[i % GF2mElement::getM()] + this->coefficients[i];
+            }
+            this->coefficients.resize(GF2mElement::getM(), GF2mElement::zero());
+        }
+    }
+
+    // Tr(x) = sum x^(2^i)
+    static LinearizedPolynomial trace() {
+        return LinearizedPolynomial(std::vector<GF2mElement>(GF2mElement::getM(), GF2mElement::one()));
+    }
+
+    const std::vector<GF2mElement>& getCoefficients() const {
+        return coefficients;
+    }
+
+    int qDegree() const {
+        int d = static_cast<int>(coefficients.size()) - 1;
+        while (d >= 0 && coefficients[d].isZero()) --d;
+        return d;
+    }
+
+    // x^(2^i) for every i the polynomial needs; reusable across polynomials evaluated at the same x
+    std::vector<GF2mElement> rotations(const GF2mElement& x) const {
+        std::vector<GF2mElement> result;
+        result.reserve(coefficients.size());
+        for (size_t i = 0; i < coefficients.size(); ++i) {
+            result.push_back(x.frobenius(static_cast<int>(i)));
+        }
+        return result;
+    }
+
+    GF2mElement evaluate(const std::vector<GF2mElement>& xRotations) const {
+        GF2mElement result = GF2mElement::zero();
+        for (size_t i = 0; i < coefficients.size() && i < xRotations.size(); ++i) {
+            if (coefficients[i].isZero()) continue;
+            result = result + (coefficients[i].isOne() ? xRotations[i] : coefficients[i] * xRotations[i]);
+        }
+        return result;
+    }
+
+    GF2mElement evaluate(const GF2mElement& x) const {
+        return evaluate(rotations(x));
+    }
+
+    std::vector<GF2mElement> batchEvaluate(const std::vector<GF2mElement>& xs, int threads = 0) const {
+        if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        std::vector<GF2mElement> result(xs.size(), GF2mElement::zero());
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads && static_cast<size_t>(t) < xs.size(); ++t) {
+            pool.emplace_back([&, t] {
+                for (size_t i = t; i < xs.size(); i += threads) {
+                    result[i] = evaluate(xs[i]);
+                }
+            });
+        }
+        for (auto& th : pool) th.join();
+        return result;
+    }
+
+    // (this o other)(x) = sum_k (sum_i a_i b_(k - i)^(2^i)) x^(2^k), indices mod m
+    LinearizedPolynomial compose(const LinearizedPolynomial& other) const {
+        const int m = GF2mElement::getM();
+        size_t size = std::min<size_t>(m, coefficients.size() + other.coefficients.size() - 1);
+        std::vector<GF2mElement> result(size, GF2mElement::zero());
+        for (size_t i = 0; i < coefficients.size(); ++i) {
+            if (coefficients[i].isZero()) continue;
+            for (size_t j = 0; j < other.coefficients.size(); ++j) {
+                if (other.coefficients[j].isZero()) continue;
+                GF2mElement b = other.coefficients[j].frobenius(static_cast<int>(i));
+                size_t k = (i + j) % m;
+                result[k] = result[k] + (coefficients[i].isOne() ? b : coefficients[i] * b);
+            }
+        }
+        return LinearizedPolynomial(result);
+    }
+
+    // column j is L(beta^(2^j)) = sum_i c_i beta^(2^(i+j)); each term is a sparse basis-element product
+    std::vector<GF2mElement> matrixColumns() const {
+        const int m = GF2mElement::getM();
+        std::vector<GF2mElement> columns;
+        columns.reserve(m);
+        for (int j = 0; j < m; ++j) {
+            GF2mElement column = GF2mElement::zero();
+            for (size_t i = 0; i < coefficients.size(); ++i) {
+                if (coefficients[i].isZero()) continue;
+                column = column + coefficients[i].multiplyByBasisElement((static_cast<int>(i) + j) % m);
+            }
+            columns.push_back(column);
+        }
+        return columns;
+    }
+
+    // one x with L(x) = c, or false if c is outside the image; kernel receives a basis of ker L
+    bool solve(const GF2mElement& c, GF2mElement& x, std::vector<GF2mElement>* kernel = nullptr) const {
+        const int m = GF2mElement::getM();
+        std::vector<GF2mElement> columns = matrixColumns();
+
+        // row r over the unknowns (coefficient of beta^(2^j) in x), augmented with bit r of c
+        std::vector<std::array<uint64_t, 4>> rows(m, std::array<uint64_t, 4>{});
+        std::vector<bool> rhs(m);
+        std::array<uint64_t, 4> target = c.toWords();
+        for (int j = 0; j < m; ++j) {
+            std::array<uint64_t, 4> col = columns[j].toWords();
+            int unknown = m - 1 - j;
+            for (int r = 0; r < m; ++r) {
+                if ((col[r / 64] >> (r % 64)) & 1) rows[r][unknown / 64] |= uint64_t(1) << (unknown % 64);
+            }
+        }
+        for (int r = 0; r < m; ++r) rhs[r] = (target[r / 64] >> (r % 64)) & 1;
+
+        std::vector<int> pivotRow(m, -1);
+        int rank = 0;
+        for (int col = 0; col < m && rank < m; ++col) {
+            int pivot = -1;
+            for (int r = rank; r < m; ++r) {
+                if ((rows[r][col / 64] >> (col % 64)) & 1) {
+                    pivot = r;
+                    break;
+                }
+            }
+            if (pivot < 0) continue;
+            std::swap(rows[pivot], rows[rank]);
+            bool tmp = rhs[pivot];
+            rhs[pivot] = rhs[rank];
+            rhs[rank] = tmp;
+            for (int r = 0; r < m; ++r) {
+                if (r != rank && ((rows[r][col / 64] >> (col % 64)) & 1)) {
+                    for (int w = 0; w < 4; ++w) rows[r][w] ^= rows[rank][w];
+                    rhs[r] = rhs[r] ^ rhs[rank];
+                }
+            }
+            pivotRow[col] = rank++;
+        }
+        for (int r = rank; r < m; ++r) {
+            if (rhs[r]) return false;
+        }
+
+        std::array<uint64_t, 4> solution{};
+        for (int col = 0; col < m; ++col) {
+            if (pivotRow[col] >= 0 && rhs[pivotRow[col]]) solution[col / 64] |= uint64_t(1) << (col % 64);
+        }
+        x = GF2mElement::fromWords(solution);
+
+        if (kernel) {
+            kernel->clear();
+            for (int free = 0; free < m; ++free) {
+                if (pivotRow[free] >= 0) continue;
+                std::array<uint64_t, 4> v{};
+                v[free / 64] |= uint64_t(1) << (free % 64);
+                for (int col = 0; col < m; ++col) {
+                    int r = pivotRow[col];
+                    if (r >= 0 && ((rows[r][free / 64] >> (free % 64)) & 1)) v[col / 64] |= uint64_t(1) << (col % 64);
+                }
+                kernel->push_back(GF2mElement::fromWords(v));
+            }
+        }
+        return true;
+    }
+};
+
+#endif //LW4_LINEARIZEDPOLYNOMIAL_H
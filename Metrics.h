@@ -0,0 +1,366 @@
+#ifndef LW4_METRICS_H
+#define LW4_METRICS_H
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// Counters, gauges and histograms for long-running modes, exposed in the Prometheus text format. Counters and
+// histograms are sharded: each thread adds to its own cache-line-sized shard with a relaxed atomic, so hot loops
+// on many threads do not contend, and a scrape sums the shards. Series are registered up front (that takes a
+// lock) and the returned references stay valid for the life of the registry. labels is the inside of the braces,
+// e.g. backend="bitsliced".
+class Metrics {
+public:
+    static const int SHARDS = 64;
+
+    class Counter {
+    private:
+        struct alignas(64) Shard {
+            std::atomic<uint64_t> value{0};
+        };
+        std::array<Shard, SHARDS> shards;
+
+    public:
+        void add(uint64_t n = 1) {
+            shards[shard()].value.fetch_add(n, std::memory_order_relaxed);
+        }
+
+        uint64_t value() const {
+            uint64_t total = 0;
+            for (const Shard& s : shards) total += s.value.load(std::memory_order_relaxed);
+            return total;
+        }
+    };
+
+    class Gauge {
+    private:
+        std::atomic<double> current{0};
+
+    public:
+        void set(double value) {
+            current.store(value, std::memory_order_relaxed);
+        }
+
+        void add(double delta) {
+            double old = current.load(std::memory_order_relaxed);
+            while (!current.compare_exchange_weak(old, old + delta, std::memory_order_relaxed)) {}
+        }
+
+        double value() const {
+            return current.load(std::memory_order_relaxed);
+        }
+    };
+
+    // counts per upper bound (and one past the last), plus the sum of the observations
+    class Histogram {
+    private:
+        static const int HISTOGRAM_SHARDS = 16;
+
+        struct alignas(64) Shard {
+            std::unique_ptr<std::atomic<uint64_t>[]> counts;
+            std::atomic<double> sum{0};
+        };
+        std::vector<double> bounds;
+        std::array<Shard, HISTOGRAM_SHARDS> shards;
+
+    public:
+        explicit Histogram(const std::vector<double>& bounds) : bounds(bounds) {
+            for (Shard& s : shards) {
+                s.counts.reset(new std::atomic<uint64_t>[bounds.size() + 1]);
+                for (size_t i = 0; i <= bounds.size(); ++i) s.counts[i].store(0);
+            }
+        }
+
+        void observe(double value) {
+            Shard& s = shards[shard() % HISTOGRAM_SHARDS];
+            size_t bucket = 0;
+            while (bucket < bounds.size() && value > bounds[bucket]) ++bucket;
+            s.counts[bucket].fetch_add(1, std::memory_order_relaxed);
+            double old = s.sum.load(std::memory_order_relaxed);
+            while (!s.sum.compare_exchange_weak(old, old + value, std::memory_order_relaxed)) {}
+        }
+
+        const std::vector<double>& getBounds() const { return bounds; }
+
+        // per-bucket counts, not cumulative, the last one above every bound
+        std::vector<uint64_t> counts() const {
+            std::vector<uint64_t> result(bounds.size() + 1);
+            for (const Shard& s : shards) {
+                for (size_t i = 0; i <= bounds.size(); ++i) result[i] += s.counts[i].load(std::memory_order_relaxed);
+            }
+            return result;
+        }
+
+        double sum() const {
+            double total = 0;
+            for (const Shard& s : shards) total += s.sum.load(std::memory_order_relaxed);
+            return total;
+        }
+    };
+
+private:
+    enum Type { COUNTER, GAUGE, HISTOGRAM };
+
+    struct Series {
+        std::string labels;
+        Counter* counter = nullptr;
+        Gauge* gauge = nullptr;
+        Histogram* histogram = nullptr;
+    };
+
+    struct Family {
+        std::string name;
+        std::string help;
+        Type type;
+        std::vector<Series> series;
+    };
+
+    mutable std::mutex mutex;
+    std::deque<Family> families;
+    std::deque<Counter> counters;
+    std::deque<Gauge> gauges;
+    std::deque<std::unique_ptr<Histogram>> histograms;
+
+    // this thread's shard, handed out round robin
+    static int shard() {
+        static std::atomic<int> next{0};
+        thread_local int index = next.fetch_add(1, std::memory_order_relaxed) % SHARDS;
+        return index;
+    }
+
+    Family& family(const std::string& name, const std::string& help, Type type) {
+        for (Family& f : families) {
+            if (f.name == name) return f;
+        }
+        families.push_back({name, help, type, {}});
+        return families.back();
+    }
+
+    static std::string braces(const std::string& labels, const std::string& extra = "") {
+        std::string inside = labels.empty() ? extra : extra.empty() ? labels : labels + "," + extra;
+        return inside.empty() ? "" : "{" + inside + "}";
+    }
+
+public:
+    Metrics() = default;
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    Counter& counter(const std::string& name, const std::string& help, const std::string& labels = "") {
+        std::lock_guard<std::mutex> lock(mutex);
+        Family& f = family(name, help, COUNTER);
+        for (Series& s : f.series) {
+            if (s.labels == labels) return *s.counter;
+        }
+        counters.emplace_back();
+        f.series.push_back({labels, &counters.back(), nullptr, nullptr});
+        return counters.back();
+    }
+
+    Gauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "") {
+        std::lock_guard<std::mutex> lock(mutex);
+        Family& f = family(name, help, GAUGE);
+        for (Series& s : f.series) {
+            if (s.labels == labels) return *s.gauge;
+        }
+        gauges.emplace_back();
+        f.series.push_back({labels, nullptr, &gauges.back(), nullptr});
+        return gauges.back();
+    }
+
+    Histogram& histogram(const std::string& name, const std::string& help, const std::vector<double>& bounds,
+                         const std::string& labels = "") {
+        std::lock_guard<std::mutex> lock(mutex);
+        Family& f = family(name, help, HISTOGRAM);
+        for (Series& s : f.series) {
+            if (s.labels == labels) return *s.histogram;
+        }
+        histograms.push_back(std::make_unique<Histogram>(bounds));
+        f.series.push_back({labels, nullptr, nullptr, histograms.back().get()});
+        return *histograms.back();
+    }
+
+    // the text exposition format, version 0.0.4
+    std::string expose() const {
+        static const char* typeNames[] = {"counter", "gauge", "histogram"};
+        std::lock_guard<std::mutex> lock(mutex);
+        std::ostringstream out;
+        out.precision(12);
+        for (const Family& f : families) {
+            out << "# HELP " << f.name << " " << f.help << "\n# TYPE " << f.name << " " << typeNames[f.type] << "\n";
+            for (const Series& s : f.series) {
+                if (s.counter) out << f.name << braces(s.labels) << " " << s.counter->value() << "\n";
+                if (s.gauge) out << f.name << braces(s.labels) << " " << s.gauge->value() << "\n";
+                if (s.histogram) {
+                    std::vector<uint64_t> counts = s.histogram->counts();
+                    const std::vector<double>& bounds = s.histogram->getBounds();
+                    uint64_t cumulative = 0;
+                    for (size_t i = 0; i < counts.size(); ++i) {
+                        cumulative += counts[i];
+                        std::ostringstream le;
+                        le.precision(12);
+                        if (i < bounds.size()) le << bounds[i];
+                        else le << "+Inf";
+                        out << f.name << "_bucket" << braces(s.labels, "le=\"" + le.str() + "\"") << " " << cumulative << "\n";
+                    }
+                    out << f.name << "_sum" << braces(s.labels) << " " << s.histogram->sum() << "\n";
+                    out << f.name << "_count" << braces(s.labels) << " " << cumulative << "\n";
+                }
+            }
+        }
+        return out.str();
+    }
+
+    // written to a temporary file and renamed, so a reader (the node_exporter textfile collector) never sees
+    // half a scrape
+    bool writeFile(const std::string& path) const {
+        std::string temporary = path + ".tmp";
+        {
+            std::ofstream out(temporary);
+            if (!out) return false;
+            out << expose();
+            if (!out) return false;
+        }
+        return std::rename(temporary.c_str(), path.c_str()) == 0;
+    }
+};
+
+// Publishes a registry until destroyed: "unix:<path>" listens on a Unix socket and answers every connection
+// with an HTTP response holding the exposition (curl --unix-socket <path> http://localhost/metrics), any other
+// target is a file rewritten every interval and once more on shutdown. start() is false if the socket or file
+// cannot be set up.
+class MetricsExporter {
+private:
+    const Metrics& metrics;
+    std::string target;
+    double interval;
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+    int listener = -1;
+
+    bool socketMode() const {
+        return target.rfind("unix:", 0) == 0;
+    }
+
+    std::string socketPath() const {
+        return target.substr(5);
+    }
+
+#ifdef __linux__
+    bool listen() {
+        std::string path = socketPath();
+        sockaddr_un address{};
+        if (path.empty() || path.size() >= sizeof(address.sun_path)) return false;
+        address.sun_family = AF_UNIX;
+        path.copy(address.sun_path, path.size());
+        listener = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0) return false;
+        unlink(path.c_str());
+        if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listener, 8) != 0) {
+            close(listener);
+            listener = -1;
+            return false;
+        }
+        return true;
+    }
+
+    void serve() {
+        while (true) {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (stopping) return;
+            }
+            pollfd waiting{listener, POLLIN, 0};
+            if (poll(&waiting, 1, 200) <= 0) continue;
+            int client = accept(listener, nullptr, nullptr);
+            if (client < 0) continue;
+            // the request itself does not matter, but read it so the client sees an orderly reply
+            pollfd request{client, POLLIN, 0};
+            char ignored[1024];
+            if (poll(&request, 1, 100) > 0) (void) read(client, ignored, sizeof(ignored));
+            std::string body = metrics.expose();
+            std::string response = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+                                   std::to_string(body.size()) + "\r\n\r\n" + body;
+            // MSG_NOSIGNAL: a scraper that hangs up early is EPIPE here, not a SIGPIPE that kills the process
+            for (size_t sent = 0; sent < response.size();) {
+                ssize_t n = send(client, response.data() + sent, response.size() - sent, MSG_NOSIGNAL);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) break;
+                sent += static_cast<size_t>(n);
+            }
+            close(client);
+        }
+    }
+#endif
+
+    void rewrite() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!stopping) {
+            wake.wait_for(lock, std::chrono::duration<double>(interval));
+            lock.unlock();
+            metrics.writeFile(target);
+            lock.lock();
+        }
+    }
+
+public:
+    MetricsExporter(const Metrics& metrics, const std::string& target, double interval = 10)
+        : metrics(metrics), target(target), interval(interval) {}
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    ~MetricsExporter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        if (thread.joinable()) thread.join();
+#ifdef __linux__
+        if (listener >= 0) {
+            close(listener);
+            unlink(socketPath().c_str());
+        }
+#endif
+    }
+
+    bool start() {
+        if (socketMode()) {
+#ifdef __linux__
+            if (!listen()) return false;
+            thread = std::thread([this] { serve(); });
+            return true;
+#else
+            return false;
+#endif
+        }
+        if (!metrics.writeFile(target)) return false;
+        thread = std::thread([this] { rewrite(); });
+        return true;
+    }
+};
+
+#endif //LW4_METRICS_H
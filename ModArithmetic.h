@@ -0,0 +1,103 @@
+#ifndef LW4_MODARITHMETIC_H
+#define LW4_MODARITHMETIC_H
+
+#include <cstdint>
+
+namespace modn {
+    inline uint64_t mul(uint64_t a, uint64_t b, uint64_t n) {
+        return static_cast<uint64_t>(static_cast<unsigned __int128>(a) * b % n);
+    }
+
+    inline uint64_t add(uint64_t a, uint64_t b, uint64_t n) {
+        uint64_t s = a + b;
+        return (s >= n || s < a) ? s - n : s;
+    }
+
+    inline uint64_t sub(uint64_t a, uint64_t b, uint64_t n) {
+        return a >= b ? a - b : a + (n - b);
+    }
+
+    inline uint64_t pow(uint64_t a, uint64_t e, uint64_t n) {
+        uint64_t result = 1 % n;
+        while (e) {
+            if (e & 1) result = mul(result, a, n);
+            a = mul(a, a, n);
+            e >>= 1;
+        }
+        return result;
+    }
+
+    // extended Euclid; a must be coprime to n
+    inline uint64_t inverse(uint64_t a, uint64_t n) {
+        __int128 r0 = n, r1 = a % n, t0 = 0, t1 = 1;
+        while (r1 != 0) {
+            __int128 q = r0 / r1;
+            __int128 r2 = r0 - q * r1;
+            __int128 t2 = t0 - q * t1;
+            r0 = r1;
+            r1 = r2;
+            t0 = t1;
+            t1 = t2;
+        }
+        if (t0 < 0) t0 += n;
+        return static_cast<uint64_t>(t0);
+    }
+
+    inline bool isPrime(uint64_t n) {
+        if (n < 2) return false;
+        for (uint64_t q : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+            if (n % q == 0) return n == q;
+        }
+        uint64_t d = n - 1;
+        int s = 0;
+        while ((d & 1) == 0) {
+            d >>= 1;
+            ++s;
+        }
+        for (uint64_t q : {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37}) {
+            uint64_t x = pow(q, d, n);
+            if (x == 1 || x == n - 1) continue;
+            bool composite = true;
+            for (int r = 1; r < s && composite; ++r) {
+                x = mul(x, x, n);
+                if (x == n - 1) composite = false;
+            }
+            if (composite) return false;
+        }
+        return true;
+    }
+
+    // Tonelli-Shanks, n an odd prime and a a quadratic residue
+    inline uint64_t sqrt(uint64_t a, uint64_t n) {
+        uint64_t q = n - 1;
+        int s = 0;
+        while ((q & 1) == 0) {
+            q >>= 1;
+            ++s;
+        }
+        uint64_t z = 2;
+        while (pow(z, (n - 1) / 2, n) != n - 1) ++z;
+
+        uint64_t c = pow(z, q, n);
+        uint64_t r = pow(a, (q + 1) / 2, n);
+        uint64_t t = pow(a, q, n);
+        int m = s;
+        while (t != 1) {
+            int i = 0;
+            uint64_t t2 = t;
+            while (t2 != 1) {
+                t2 = mul(t2, t2, n);
+                ++i;
+            }
+            uint64_t b = c;
+            for (int j = 0; j < m - i - 1; ++j) b = mul(b, b, n);
+            r = mul(r, b, n);
+            c = mul(b, b, n);
+            t = mul(t, c, n);
+            m = i;
+        }
+        return r;
+    }
+}
+
+#endif //LW4_MODARITHMETIC_H
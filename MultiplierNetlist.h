@@ -0,0 +1,248 @@
+#ifndef LW4_MULTIPLIERNETLIST_H
+#define LW4_MULTIPLIERNETLIST_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "LambdaTable.h"
+
+// Combinational AND/XOR network over the inputs a[0..m-1], b[0..m-1]. Gates are hash-consed, so a term
+// used by several outputs is built once, and each node keeps its depth in gate levels.
+class GateNetlist {
+public:
+    enum Op { INPUT, AND, XOR };
+
+    struct Gate {
+        Op op;
+        int left;
+        int right;
+    };
+
+private:
+    int m;
+    std::vector<Gate> gates;
+    std::vector<int> andLevels;
+    std::vector<int> xorLevels;
+    std::unordered_map<uint64_t, int> existing;
+    std::vector<int> outputs;
+
+    int addGate(Op op, int x, int y) {
+        if (x > y) std::swap(x, y);
+        uint64_t key = (uint64_t(op) << 62) | (uint64_t(x) << 31) | uint64_t(y);
+        auto it = existing.find(key);
+        if (it != existing.end()) return it->second;
+        int id = static_cast<int>(gates.size());
+        gates.push_back({op, x, y});
+        andLevels.push_back(std::max(andLevels[x], andLevels[y]) + (op == AND));
+        xorLevels.push_back(std::max(xorLevels[x], xorLevels[y]) + (op == XOR));
+        existing.emplace(key, id);
+        return id;
+    }
+
+public:
+    explicit GateNetlist(int m) : m(m) {
+        for (int i = 0; i < 2 * m; ++i) {
+            gates.push_back({INPUT, -1, -1});
+            andLevels.push_back(0);
+            xorLevels.push_back(0);
+        }
+    }
+
+    int getM() const { return m; }
+    int a(int i) const { return i; }
+    int b(int i) const { return m + i; }
+
+    int andGate(int x, int y) { return addGate(AND, x, y); }
+    int xorGate(int x, int y) { return addGate(XOR, x, y); }
+
+    // XOR of all terms, always joining the two shallowest nodes, so the tree is as flat as the inputs allow
+    int xorTree(const std::vector<int>& terms) {
+        using Entry = std::pair<int, int>; // (depth, node)
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+        for (int t : terms) queue.emplace(xorLevels[t], t);
+        while (queue.size() > 1) {
+            int x = queue.top().second;
+            queue.pop();
+            int y = queue.top().second;
+            queue.pop();
+            int z = xorGate(x, y);
+            queue.emplace(xorLevels[z], z);
+        }
+        return queue.empty() ? -1 : queue.top().second;
+    }
+
+    void addOutput(int node) { outputs.push_back(node); }
+
+    const std::vector<Gate>& getGates() const { return gates; }
+    const std::vector<int>& getOutputs() const { return outputs; }
+
+    int count(Op op) const {
+        return static_cast<int>(std::count_if(gates.begin(), gates.end(), [op](const Gate& g) { return g.op == op; }));
+    }
+
+    // critical path as T_A levels + T_X levels (taken over the deepest output in XOR levels)
+    std::pair<int, int> criticalPath() const {
+        std::pair<int, int> path{0, 0};
+        for (int out : outputs) {
+            if (out < 0) continue;
+            std::pair<int, int> p{andLevels[out], xorLevels[out]};
+            if (p.second > path.second || (p.second == path.second && p.first > path.first)) path = p;
+        }
+        return path;
+    }
+
+    std::string nodeName(int id) const {
+        if (id < m) return "a[" + std::to_string(id) + "]";
+        if (id < 2 * m) return "b[" + std::to_string(id - m) + "]";
+        return "n" + std::to_string(id);
+    }
+
+    // the gate assignments of the network, outputs driven onto out[k]
+    void writeVerilogBody(std::ostream& os, const std::string& out) const {
+        for (size_t id = 2 * m; id < gates.size(); ++id) os << "    wire n" << id << ";\n";
+        for (size_t id = 2 * m; id < gates.size(); ++id) {
+            const Gate& g = gates[id];
+            os << "    assign n" << id << " = " << nodeName(g.left) << (g.op == AND ? " & " : " ^ ")
+               << nodeName(g.right) << ";\n";
+        }
+        for (size_t k = 0; k < outputs.size(); ++k) {
+            os << "    assign " << out << "[" << k << "] = " << (outputs[k] < 0 ? "1'b0" : nodeName(outputs[k])) << ";\n";
+        }
+    }
+
+    void writeJsonGraph(std::ostream& os) const {
+        os << "  \"inputs\": " << 2 * m << ",\n  \"gates\": [\n";
+        bool first = true;
+        for (size_t id = 2 * m; id < gates.size(); ++id) {
+            const Gate& g = gates[id];
+            os << (first ? "" : ",\n") << "    {\"id\": " << id << ", \"op\": \"" << (g.op == AND ? "and" : "xor")
+               << "\", \"in\": [" << g.left << ", " << g.right << "]}";
+            first = false;
+        }
+        os << "\n  ],\n  \"outputs\": [";
+        for (size_t k = 0; k < outputs.size(); ++k) os << (k ? ", " : "") << outputs[k];
+        os << "]";
+    }
+};
+
+// Massey-Omura multiplier from a normal basis lambda table: c_k = sum lambda_ij a_(i+k) b_(j+k), with a[i] the
+// coefficient of beta^(2^i) (coefficients[m - 1 - i] of GF2mElement). lambda is symmetric, so each pair
+// a_x b_y + a_y b_x is rewritten as (a_x + a_y)(b_x + b_y) + a_x b_x + a_y b_y (Reyhani-Masoleh and Hasan):
+// one AND per pair, and the diagonal products a_x b_x are shared by all outputs.
+//
+// digit = m is the bit-parallel multiplier, 1 < digit < m the digit-serial one computing digit output bits per
+// clock from rotating registers, digit = 1 the sequential Massey-Omura multiplier.
+class MultiplierNetlist {
+private:
+    LambdaTable table;
+    int digit;
+    GateNetlist network;
+
+    // output k of the product as a network node
+    int outputBit(int k) {
+        const int m = table.m;
+        std::vector<char> diagonal(m, 0);
+        std::vector<int> terms;
+        for (const auto& [i, j] : table.ones) {
+            int x = (i + k) % m, y = (j + k) % m;
+            if (x == y) {
+                diagonal[x] ^= 1;
+            } else if (i < j) {
+                int sumA = network.xorGate(network.a(x), network.a(y));
+                int sumB = network.xorGate(network.b(x), network.b(y));
+                terms.push_back(network.andGate(sumA, sumB));
+                diagonal[x] ^= 1;
+                diagonal[y] ^= 1;
+            }
+        }
+        for (int x = 0; x < m; ++x) {
+            if (diagonal[x]) terms.push_back(network.andGate(network.a(x), network.b(x)));
+        }
+        return network.xorTree(terms);
+    }
+
+public:
+    MultiplierNetlist(const LambdaTable& table, int digit)
+        : table(table), digit(std::max(1, std::min(digit, table.m))), network(table.m) {
+        for (int k = 0; k < this->digit; ++k) network.addOutput(outputBit(k));
+    }
+
+    const GateNetlist& getNetwork() const { return network; }
+    int getDigit() const { return digit; }
+
+    int cycles() const {
+        return (table.m + digit - 1) / digit;
+    }
+
+    std::string architecture() const {
+        if (digit == table.m) return "bit-parallel";
+        if (digit == 1) return "sequential";
+        return "digit-serial";
+    }
+
+    // the sequential designs also need the two rotating operand registers and the product register
+    int flipFlops() const {
+        return digit == table.m ? 0 : 3 * table.m;
+    }
+
+    // structural Verilog: the combinational core, wrapped in a load/rotate datapath unless bit-parallel
+    void writeVerilog(std::ostream& os, const std::string& name) const {
+        const int m = table.m;
+        if (digit == m) {
+            os << "// " << architecture() << " normal basis multiplier, GF(2^" << m << "), C_N = " << table.complexity() << "\n";
+            os << "module " << name << "(input [" << m - 1 << ":0] a, input [" << m - 1 << ":0] b, output ["
+               << m - 1 << ":0] c);\n";
+            network.writeVerilogBody(os, "c");
+            os << "endmodule\n";
+            return;
+        }
+
+        os << "// " << digit << " output bits of a normal basis product, GF(2^" << m << ")\n";
+        os << "module " << name << "_core(input [" << m - 1 << ":0] a, input [" << m - 1 << ":0] b, output ["
+           << digit - 1 << ":0] c);\n";
+        network.writeVerilogBody(os, "c");
+        os << "endmodule\n\n";
+
+        os << "// " << architecture() << " normal basis multiplier, " << cycles() << " cycles after load\n";
+        os << "module " << name << "(input clk, input load, input [" << m - 1 << ":0] a_in, input [" << m - 1
+           << ":0] b_in, output reg [" << m - 1 << ":0] c, output reg done);\n";
+        os << "    reg [" << m - 1 << ":0] a;\n    reg [" << m - 1 << ":0] b;\n";
+        os << "    reg [31:0] step;\n    wire [" << digit - 1 << ":0] digit_out;\n";
+        os << "    " << name << "_core core(.a(a), .b(b), .c(digit_out));\n";
+        os << "    integer t;\n";
+        os << "    always @(posedge clk) begin\n";
+        os << "        if (load) begin\n";
+        os << "            a <= a_in;\n            b <= b_in;\n            step <= 0;\n            done <= 0;\n";
+        os << "        end else if (!done) begin\n";
+        os << "            for (t = 0; t < " << digit << "; t = t + 1)\n";
+        os << "                if (step * " << digit << " + t < " << m << ") c[step * " << digit
+           << " + t] <= digit_out[t];\n";
+        // rotating both operands by digit positions moves outputs digit..2 digit - 1 to the core outputs
+        os << "            a <= {a[" << digit - 1 << ":0], a[" << m - 1 << ":" << digit << "]};\n";
+        os << "            b <= {b[" << digit - 1 << ":0], b[" << m - 1 << ":" << digit << "]};\n";
+        os << "            step <= step + 1;\n";
+        os << "            done <= (step == " << cycles() - 1 << ");\n";
+        os << "        end\n    end\nendmodule\n";
+    }
+
+    void writeJson(std::ostream& os, const std::string& name) const {
+        auto path = network.criticalPath();
+        os << "{\n  \"module\": \"" << name << "\",\n  \"architecture\": \"" << architecture() << "\",\n";
+        os << "  \"m\": " << table.m << ",\n  \"complexity\": " << table.complexity() << ",\n";
+        os << "  \"digit\": " << digit << ",\n  \"cycles\": " << cycles() << ",\n";
+        os << "  \"and\": " << network.count(GateNetlist::AND) << ",\n  \"xor\": " << network.count(GateNetlist::XOR)
+           << ",\n";
+        os << "  \"flip_flops\": " << flipFlops() << ",\n";
+        os << "  \"critical_path\": {\"and\": " << path.first << ", \"xor\": " << path.second << "},\n";
+        network.writeJsonGraph(os);
+        os << "\n}\n";
+    }
+};
+
+#endif //LW4_MULTIPLIERNETLIST_H
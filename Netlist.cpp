@@ -0,0 +1,58 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "GF2mElement.h"
+#include "MultiplierNetlist.h"
+
+// usage: Netlist [digit] [output prefix] [lambda table file] [T_A ps] [T_X ps]
+// writes <prefix>_parallel, <prefix>_digit<d> and <prefix>_serial as .v and .json and prints gate counts,
+// critical paths and, when gate delays are given, the predicted multiplications per second
+int main(int argc, char* argv[]) {
+    int digit = argc > 1 ? std::atoi(argv[1]) : 8;
+    std::string prefix = argc > 2 ? argv[2] : "onb" + std::to_string(GF2mElement::getM());
+    double andDelay = argc > 4 ? std::atof(argv[4]) : 0;
+    double xorDelay = argc > 5 ? std::atof(argv[5]) : 0;
+
+    LambdaTable table;
+    if (argc > 3 && std::string(argv[3]) != "-") {
+        if (!LambdaTable::load(argv[3], table)) {
+            std::cerr << "Cannot load lambda table " << argv[3] << std::endl;
+            return 1;
+        }
+    } else {
+        table.m = GF2mElement::getM();
+        table.type = 2;
+        table.ones = GF2mElement::createMultiplicativeMatrix();
+    }
+    std::cout << "GF(2^" << table.m << "), C_N = " << table.complexity() << std::endl;
+
+    std::vector<std::pair<std::string, int>> designs = {
+            {"parallel", table.m}, {"digit" + std::to_string(digit), digit}, {"serial", 1}};
+    for (const auto& [suffix, d] : designs) {
+        MultiplierNetlist netlist(table, d);
+        std::string path = prefix + "_" + suffix;
+        std::string name = path.substr(path.find_last_of('/') + 1);
+        std::ofstream verilog(path + ".v");
+        netlist.writeVerilog(verilog, name);
+        std::ofstream json(path + ".json");
+        netlist.writeJson(json, name);
+        if (!verilog || !json) {
+            std::cerr << "Cannot write " << path << std::endl;
+            return 1;
+        }
+
+        const GateNetlist& network = netlist.getNetwork();
+        auto critical = network.criticalPath();
+        std::cout << netlist.architecture() << " (digit " << netlist.getDigit() << "): "
+                  << network.count(GateNetlist::AND) << " AND, " << network.count(GateNetlist::XOR) << " XOR, "
+                  << netlist.flipFlops() << " FF, path " << critical.first << " T_A + " << critical.second << " T_X, "
+                  << netlist.cycles() << " cycles";
+        if (andDelay > 0 || xorDelay > 0) {
+            double period = critical.first * andDelay + critical.second * xorDelay;
+            std::cout << ", " << 1e12 / (period * netlist.cycles()) / 1e6 << " M mul/s";
+        }
+        std::cout << " -> " << path << ".v" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+#ifndef LW4_NIST233_H
+#define LW4_NIST233_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "BasisConversion.h"
+#include "BinaryCurve.h"
+#include "GF2mElement.h"
+
+// The NIST curves B-233 and K-233 (FIPS 186-4, D.1.3.2) in type II ONB coordinates. The standard gives b and
+// the base points in the polynomial basis GF(2)[x]/(x^233 + x^74 + 1); they go through
+// BasisConversion::fromTrinomial, which finds a root of the trinomial in the ONB the first time (about a second).
+// Orders are binary strings, most significant bit first, for BinaryCurve::multiply.
+class Nist233 {
+private:
+    using Words = std::array<uint64_t, 4>;
+
+    static constexpr const char* B233_B = "0066647ede6c332c7f8c0923bb58213b333b20e9ce4281fe115f7d8f90ad";
+    static constexpr const char* B233_GX = "00fac9dfcbac8313bb2139f1bb755fef65bc391f8b36f8f8eb7371fd558b";
+    static constexpr const char* B233_GY = "01006a08a41903350678e58528bebf8a0beff867a7ca36716f7e01f81052";
+    static constexpr const char* B233_N = "01000000000000000000000000000013e974e72f8a6922031d2603cfe0d7";
+    static constexpr const char* K233_GX = "017232ba853a7e731af129f22ff4149563a419c26bf50a4c9d6eefad6126";
+    static constexpr const char* K233_GY = "01db537dece819b7f70f555a67c427a8cd9bf18aeb9b56e0c11056fae6a3";
+    static constexpr const char* K233_N = "8000000000000000000000000000069d5bb915bcd46efb1ad5f173abdf";
+
+    static int digit(char c) {
+        return c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10;
+    }
+
+    // bit k is the coefficient of x^k
+    static Words words(const std::string& hex) {
+        Words result{};
+        int bit = 0;
+        for (size_t i = hex.size(); i-- > 0; bit += 4) {
+            result[bit / 64] |= uint64_t(digit(hex[i])) << (bit % 64);
+        }
+        return result;
+    }
+
+    static std::string bits(const std::string& hex) {
+        std::string result;
+        for (char c : hex) {
+            for (int b = 3; b >= 0; --b) result.push_back((digit(c) >> b) & 1 ? '1' : '0');
+        }
+        return result.substr(result.find('1'));
+    }
+
+    static std::vector<GF2mElement> convert(const std::vector<const char*>& hex) {
+        std::vector<Words> coordinates;
+        for (const char* h : hex) coordinates.push_back(words(h));
+        return BasisConversion::fromTrinomial(coordinates);
+    }
+
+public:
+    // y^2 + xy = x^3 + x^2 + b
+    static BinaryCurve<GF2mElement> b233() {
+        static const GF2mElement b = convert({B233_B})[0];
+        return BinaryCurve<GF2mElement>(GF2mElement::one(), b);
+    }
+
+    static BinaryPoint<GF2mElement> b233Generator() {
+        static const std::vector<GF2mElement> g = convert({B233_GX, B233_GY});
+        return BinaryPoint<GF2mElement>(g[0], g[1]);
+    }
+
+    static std::string b233Order() {
+        return bits(B233_N);
+    }
+
+    // y^2 + xy = x^3 + 1, the same as BinaryCurve<GF2mElement>::koblitz(0)
+    static BinaryCurve<GF2mElement> k233() {
+        return BinaryCurve<GF2mElement>::koblitz(0);
+    }
+
+    static BinaryPoint<GF2mElement> k233Generator() {
+        static const std::vector<GF2mElement> g = convert({K233_GX, K233_GY});
+        return BinaryPoint<GF2mElement>(g[0], g[1]);
+    }
+
+    static std::string k233Order() {
+        return bits(K233_N);
+    }
+};
+
+#endif //LW4_NIST233_H
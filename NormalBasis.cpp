@@ -0,0 +1,55 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "NormalBasisSearch.h"
+
+// usage: NormalBasis [m] [max Gaussian type] [random candidates] [threads] [output file]
+// prints C_N of every Gaussian normal basis of GF(2^m) and of the best random normal element,
+// and writes the cheapest lambda table (default lambda_<m>.bin)
+int main(int argc, char* argv[]) {
+    int m = argc > 1 ? std::atoi(argv[1]) : 233;
+    int maxT = argc > 2 ? std::atoi(argv[2]) : 20;
+    int candidates = argc > 3 ? std::atoi(argv[3]) : 256;
+    int threads = argc > 4 ? std::atoi(argv[4]) : static_cast<int>(std::thread::hardware_concurrency());
+    std::string output = argc > 5 ? argv[5] : "lambda_" + std::to_string(m) + ".bin";
+    if (m < 2) {
+        std::cerr << "m must be at least 2" << std::endl;
+        return 1;
+    }
+
+    LambdaTable best;
+    for (int T : NormalBasisSearch::gaussianTypes(m, maxT)) {
+        LambdaTable table = NormalBasisSearch::gaussianTable(m, T);
+        std::cout << "Gaussian type " << T << (T <= 2 ? " (ONB)" : "") << ", p = " << T * m + 1
+                  << ": C_N = " << table.complexity() << std::endl;
+        if (best.ones.empty() || table.complexity() < best.complexity()) best = table;
+    }
+
+    PolynomialBasisField field = PolynomialBasisField::lowWeight(m);
+    std::cout << "Polynomial basis: x^" << m;
+    for (int t : field.getTerms()) std::cout << " + x^" << t;
+    std::cout << std::endl;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    LambdaTable found = NormalBasisSearch::search(field, candidates, threads);
+    auto stop = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(stop - start).count();
+    if (found.ones.empty()) {
+        std::cout << "Search: no normal element among " << candidates << " candidates" << std::endl;
+    } else {
+        std::cout << "Search: best C_N = " << found.complexity() << " over " << candidates << " candidates, "
+                  << seconds << " s" << std::endl;
+        if (best.ones.empty() || found.complexity() < best.complexity()) best = found;
+    }
+
+    if (best.ones.empty()) return 1;
+    std::cout << "Lower bound 2m - 1 = " << 2 * m - 1 << std::endl;
+    if (!best.save(output)) {
+        std::cerr << "Cannot write " << output << std::endl;
+        return 1;
+    }
+    std::cout << "Wrote " << output << " (type " << best.type << ", C_N = " << best.complexity() << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,313 @@
+#ifndef LW4_NORMALBASISSEARCH_H
+#define LW4_NORMALBASISSEARCH_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+#include "LambdaTable.h"
+#include "ModArithmetic.h"
+
+// GF(2^m) = GF(2)[x]/f for a low-weight irreducible f, elements as bit vectors packed into 64-bit words.
+// Only what the normal basis search needs: multiplication, squaring and the irreducibility test.
+class PolynomialBasisField {
+public:
+    using Element = std::vector<uint64_t>;
+
+private:
+    int m;
+    int words;
+    std::vector<int> terms; // exponents of f below m
+
+    static bool bit(const Element& a, int i) {
+        return (a[i / 64] >> (i % 64)) & 1;
+    }
+
+    static void flip(Element& a, int i) {
+        a[i / 64] ^= uint64_t(1) << (i % 64);
+    }
+
+    static int degree(const Element& a) {
+        for (int w = static_cast<int>(a.size()) - 1; w >= 0; --w) {
+            if (a[w]) return 64 * w + 63 - __builtin_clzll(a[w]);
+        }
+        return -1;
+    }
+
+    // a mod b for arbitrary polynomials, bit by bit
+    static Element remainder(Element a, const Element& b) {
+        int db = degree(b);
+        for (int d = degree(a); d >= db; --d) {
+            if (!bit(a, d)) continue;
+            for (int i = 0; i <= db; ++i) {
+                if (bit(b, i)) flip(a, d - db + i);
+            }
+        }
+        return a;
+    }
+
+    static Element gcd(Element a, Element b) {
+        while (degree(b) >= 0) {
+            Element r = remainder(a, b);
+            a = std::move(b);
+            b = std::move(r);
+        }
+        return a;
+    }
+
+    // the full polynomial f = x^m + sum x^t
+    Element modulus() const {
+        Element f(m / 64 + 1, 0);
+        flip(f, m);
+        for (int t : terms) flip(f, t);
+        return f;
+    }
+
+    // Rabin: f is irreducible iff x^(2^m) = x mod f and gcd(x^(2^(m/q)) - x, f) = 1 for every prime q | m
+    bool irreducible() const {
+        std::vector<int> primes;
+        for (int q = 2, r = m; q <= r; ++q) {
+            if (r % q) continue;
+            primes.push_back(q);
+            while (r % q == 0) r /= q;
+        }
+        Element x = zero();
+        flip(x, 1);
+        Element f = modulus();
+        for (int q : primes) {
+            Element y = x;
+            for (int i = 0; i < m / q; ++i) y = square(y);
+            y = add(y, x);
+            Element g = gcd(f, y);
+            if (degree(g) != 0) return false;
+        }
+        Element y = x;
+        for (int i = 0; i < m; ++i) y = square(y);
+        return y == x;
+    }
+
+public:
+    PolynomialBasisField(int m, const std::vector<int>& terms) : m(m), words((m + 63) / 64), terms(terms) {}
+
+    // the first irreducible trinomial x^m + x^k + 1, otherwise the first pentanomial x^m + x^a + x^b + x^c + 1
+    static PolynomialBasisField lowWeight(int m) {
+        for (int k = 1; k < m; ++k) {
+            PolynomialBasisField field(m, {k, 0});
+            if (field.irreducible()) return field;
+        }
+        for (int a = 3; a < m; ++a) {
+            for (int b = 2; b < a; ++b) {
+                for (int c = 1; c < b; ++c) {
+                    PolynomialBasisField field(m, {a, b, c, 0});
+                    if (field.irreducible()) return field;
+                }
+            }
+        }
+        return PolynomialBasisField(m, {});
+    }
+
+    int getM() const { return m; }
+    int getWords() const { return words; }
+    const std::vector<int>& getTerms() const { return terms; }
+
+    Element zero() const {
+        return Element(words, 0);
+    }
+
+    Element random(std::mt19937_64& rng) const {
+        Element a(words);
+        for (auto& w : a) w = rng();
+        if (m % 64) a[words - 1] &= (uint64_t(1) << (m % 64)) - 1;
+        return a;
+    }
+
+    static Element add(Element a, const Element& b) {
+        for (size_t w = 0; w < a.size(); ++w) a[w] ^= b[w];
+        return a;
+    }
+
+    // comb multiplication into 2m bits, then the sparse reduction x^m = sum x^t from the top bit down
+    Element multiply(const Element& a, const Element& b) const {
+        Element product(2 * words + 1, 0);
+        for (int k = 63; k >= 0; --k) {
+            for (int w = 0; w < words; ++w) {
+                if (!((a[w] >> k) & 1)) continue;
+                for (int v = 0; v < words; ++v) product[w + v] ^= b[v];
+            }
+            if (k == 0) break;
+            for (int w = 2 * words; w > 0; --w) product[w] = (product[w] << 1) | (product[w - 1] >> 63);
+            product[0] <<= 1;
+        }
+        for (int d = 2 * m - 2; d >= m; --d) {
+            if (!bit(product, d)) continue;
+            flip(product, d);
+            for (int t : terms) flip(product, d - m + t);
+        }
+        product.resize(words);
+        return product;
+    }
+
+    Element square(const Element& a) const {
+        return multiply(a, a);
+    }
+};
+
+// Complexity C_N of normal bases of GF(2^m): the Gaussian period bases of type T exist for p = Tm + 1 prime with
+// gcd(Tm / ord_p(2), m) = 1 (T = 1, 2 are the optimal ones with C_N = 2m - 1, the lower bound);
+// any other normal element is tried by building its lambda table in a polynomial basis.
+class NormalBasisSearch {
+private:
+    static int orderOfTwo(int p) {
+        int order = 1;
+        for (uint64_t x = 2 % p; x != 1; x = x * 2 % p) ++order;
+        return order;
+    }
+
+    using Matrix = std::vector<PolynomialBasisField::Element>;
+
+    // Gauss-Jordan inverse over GF(2); false if the rows are dependent
+    static bool invert(Matrix rows, int m, Matrix& inverse) {
+        int words = static_cast<int>(rows[0].size());
+        inverse.assign(m, PolynomialBasisField::Element(words, 0));
+        for (int i = 0; i < m; ++i) inverse[i][i / 64] |= uint64_t(1) << (i % 64);
+        for (int col = 0; col < m; ++col) {
+            int w = col / 64;
+            uint64_t b = uint64_t(1) << (col % 64);
+            int pivot = col;
+            while (pivot < m && !(rows[pivot][w] & b)) ++pivot;
+            if (pivot == m) return false;
+            std::swap(rows[pivot], rows[col]);
+            std::swap(inverse[pivot], inverse[col]);
+            for (int r = 0; r < m; ++r) {
+                if (r == col || !(rows[r][w] & b)) continue;
+                for (int v = 0; v < words; ++v) {
+                    rows[r][v] ^= rows[col][v];
+                    inverse[r][v] ^= inverse[col][v];
+                }
+            }
+        }
+        return true;
+    }
+
+public:
+    static bool hasGaussianBasis(int m, int T) {
+        uint64_t p = uint64_t(T) * m + 1;
+        if (!modn::isPrime(p)) return false;
+        int k = orderOfTwo(static_cast<int>(p));
+        return std::gcd(T * m / k, m) == 1;
+    }
+
+    static std::vector<int> gaussianTypes(int m, int maxT) {
+        std::vector<int> types;
+        for (int T = 1; T <= maxT; ++T) {
+            if (hasGaussianBasis(m, T)) types.push_back(T);
+        }
+        return types;
+    }
+
+    // alpha = sum_(k in K) gamma^k for the order T subgroup K of Z_p^*. In alpha^(2^i) * alpha^(2^j) every exponent
+    // e = 2^i a + 2^j b (a, b in K) lying in K adds 1/T of a copy of alpha, and every e = 0 adds 1 = sum alpha^(2^l)
+    static LambdaTable gaussianTable(int m, int T) {
+        int p = T * m + 1;
+        std::vector<char> inK(p, 0);
+        std::vector<int> K;
+        for (int e = 1; e < p; ++e) {
+            if (modn::pow(e, T, p) == 1) {
+                inK[e] = 1;
+                K.push_back(e);
+            }
+        }
+        std::vector<int> pow2(m);
+        pow2[0] = 1;
+        for (int i = 1; i < m; ++i) pow2[i] = pow2[i - 1] * 2 % p;
+
+        LambdaTable table;
+        table.m = m;
+        table.type = T;
+        for (int i = 0; i < m; ++i) {
+            for (int j = 0; j < m; ++j) {
+                int inCoset = 0, zeros = 0;
+                for (int a : K) {
+                    for (int b : K) {
+                        int e = (pow2[i] * a + pow2[j] * b) % p;
+                        if (e == 0) ++zeros;
+                        else if (inK[e]) ++inCoset;
+                    }
+                }
+                if ((inCoset / T + zeros) & 1) table.ones.emplace_back(i, j);
+            }
+        }
+        return table;
+    }
+
+    // lambda table of the normal element alpha, or an empty table if alpha is not normal. Row j of T is
+    // alpha * alpha^(2^j) in normal coordinates; lambda_ij = T[j - i][-i]. Gives up once C_N exceeds limit.
+    static LambdaTable tableOf(const PolynomialBasisField& field, const PolynomialBasisField::Element& alpha,
+                               int limit = -1) {
+        const int m = field.getM();
+        Matrix conjugates(m);
+        conjugates[0] = alpha;
+        for (int i = 1; i < m; ++i) conjugates[i] = field.square(conjugates[i - 1]);
+        Matrix inverse;
+        LambdaTable table;
+        table.m = m;
+        if (!invert(conjugates, m, inverse)) return table;
+
+        // coordinates of y in the basis: the XOR of the rows of the inverse selected by the bits of y
+        std::vector<PolynomialBasisField::Element> T(m);
+        int weight = 0;
+        for (int j = 0; j < m; ++j) {
+            PolynomialBasisField::Element y = field.multiply(alpha, conjugates[j]);
+            PolynomialBasisField::Element x = field.zero();
+            for (int b = 0; b < m; ++b) {
+                if (!((y[b / 64] >> (b % 64)) & 1)) continue;
+                for (size_t w = 0; w < x.size(); ++w) x[w] ^= inverse[b][w];
+            }
+            for (uint64_t w : x) weight += __builtin_popcountll(w);
+            if (limit >= 0 && weight > limit) return LambdaTable{m, 0, {}};
+            T[j] = std::move(x);
+        }
+        for (int i = 0; i < m; ++i) {
+            int col = (m - i) % m;
+            for (int j = 0; j < m; ++j) {
+                const auto& row = T[(j - i + m) % m];
+                if ((row[col / 64] >> (col % 64)) & 1) table.ones.emplace_back(i, j);
+            }
+        }
+        return table;
+    }
+
+    // random normal elements on every thread; returns the lowest C_N found (empty if none was normal)
+    static LambdaTable search(const PolynomialBasisField& field, int candidates, int threads = 0, uint64_t seed = 1) {
+        if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        std::atomic<int> next(0);
+        std::atomic<int> bestWeight(field.getM() * field.getM() + 1);
+        LambdaTable best;
+        std::mutex bestMutex;
+
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; ++t) {
+            pool.emplace_back([&, t] {
+                std::mt19937_64 rng(seed + t);
+                while (next.fetch_add(1) < candidates) {
+                    LambdaTable table = tableOf(field, field.random(rng), bestWeight.load() - 1);
+                    if (table.ones.empty()) continue;
+                    std::lock_guard<std::mutex> lock(bestMutex);
+                    if (table.complexity() < bestWeight.load()) {
+                        bestWeight = table.complexity();
+                        best = std::move(table);
+                    }
+                }
+            });
+        }
+        for (auto& th : pool) th.join();
+        return best;
+    }
+};
+
+#endif //LW4_NORMALBASISSEARCH_H
@@ -0,0 +1,219 @@
+#ifndef LW4_POHLIGHELLMAN_H
+#define LW4_POHLIGHELLMAN_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+#include "GF2mElement.h"
+#include "ModArithmetic.h"
+
+// Open-addressing (linear probing) table from packed elements to baby-step indices.
+// The full packed element is kept next to its hash, so a hit never needs a recomputation to confirm.
+class PackedElementTable {
+private:
+    struct Slot {
+        uint64_t hash;
+        std::array<uint64_t, 4> words;
+        uint64_t index;
+        bool used;
+    };
+
+    std::vector<Slot> slots;
+    uint64_t mask;
+
+public:
+    explicit PackedElementTable(size_t capacity) {
+        size_t size = 1;
+        while (size < 2 * capacity) size <<= 1;
+        slots.assign(size, Slot{0, {}, 0, false});
+        mask = size - 1;
+    }
+
+    static uint64_t hashWords(const std::array<uint64_t, 4>& words) {
+        uint64_t h = 0x243F6A8885A308D3ULL;
+        for (uint64_t w : words) {
+            h ^= w;
+            h *= 0x9E3779B97F4A7C15ULL;
+            h ^= h >> 29;
+        }
+        return h;
+    }
+
+    // keeps the first index stored for an element
+    void insert(const std::array<uint64_t, 4>& words, uint64_t index) {
+        uint64_t h = hashWords(words);
+        for (uint64_t pos = h & mask;; pos = (pos + 1) & mask) {
+            Slot& slot = slots[pos];
+            if (!slot.used) {
+                slot = Slot{h, words, index, true};
+                return;
+            }
+            if (slot.hash == h && slot.words == words) return;
+        }
+    }
+
+    bool find(const std::array<uint64_t, 4>& words, uint64_t& index) const {
+        uint64_t h = hashWords(words);
+        for (uint64_t pos = h & mask;; pos = (pos + 1) & mask) {
+            const Slot& slot = slots[pos];
+            if (!slot.used) return false;
+            if (slot.hash == h && slot.words == words) {
+                index = slot.index;
+                return true;
+            }
+        }
+    }
+};
+
+// Discrete logarithms in the smooth part of GF(2^m)*: 2^233 - 1 = 1399 * 135607 * 622577 * p187,
+// so logs are recovered modulo 1399 * 135607 * 622577 by Pohlig-Hellman over baby-step giant-step.
+class PohligHellman {
+public:
+    struct Factor {
+        uint64_t prime;
+        int exponent;
+    };
+
+    struct Result {
+        uint64_t log;
+        uint64_t modulus;
+    };
+
+    static const uint64_t NOT_FOUND = ~uint64_t(0);
+
+    static std::string toBinary(uint64_t value) {
+        if (value == 0) return "0";
+        std::string bits;
+        for (int i = 63 - __builtin_clzll(value); i >= 0; --i) {
+            bits.push_back(((value >> i) & 1) ? '1' : '0');
+        }
+        return bits;
+    }
+
+    // prime factors of 2^m - 1 below the bound; each is 1 mod 2m
+    static std::vector<Factor> smoothFactors(uint64_t bound = 1000000) {
+        const uint64_t m = GF2mElement::getM();
+        std::vector<Factor> factors;
+        for (uint64_t q = 2 * m + 1; q < bound; q += 2 * m) {
+            if (!modn::isPrime(q) || modn::pow(2, m, q) != 1) continue;
+            int e = 1;
+            uint64_t qe = q;
+            while (qe <= (uint64_t(1) << 32) && modn::pow(2, m, qe * q) == 1) {
+                qe *= q;
+                ++e;
+            }
+            factors.push_back({q, e});
+        }
+        return factors;
+    }
+
+    // binary string of (2^m - 1) / d, by long division of the all-ones dividend
+    static std::string cofactorExponent(uint64_t d) {
+        std::string quotient;
+        unsigned __int128 remainder = 0;
+        for (int i = 0; i < GF2mElement::getM(); ++i) {
+            remainder = remainder * 2 + 1;
+            if (remainder >= d) {
+                quotient.push_back('1');
+                remainder -= d;
+            } else if (!quotient.empty()) {
+                quotient.push_back('0');
+            }
+        }
+        return quotient.empty() ? "0" : quotient;
+    }
+
+    // x in [0, order) with g^x = h, or NOT_FOUND; baby and giant steps are split across threads
+    static uint64_t babyStepGiantStep(const GF2mElement& g, const GF2mElement& h, uint64_t order, int threads = 0) {
+        if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        uint64_t B = 1;
+        while (B * B < order) ++B;
+        uint64_t giants = (order + B - 1) / B;
+
+        std::vector<std::array<uint64_t, 4>> baby(B);
+        auto babyRange = [&](uint64_t from, uint64_t to) {
+            GF2mElement x = g.power(toBinary(from));
+            for (uint64_t j = from; j < to; ++j) {
+                baby[j] = x.toWords();
+                x = x * g;
+            }
+        };
+        runSplit(B, threads, babyRange);
+
+        PackedElementTable table(B);
+        for (uint64_t j = 0; j < B; ++j) {
+            table.insert(baby[j], j);
+        }
+
+        GF2mElement stride = g.power(toBinary(B)).inverse();
+        std::atomic<uint64_t> answer{NOT_FOUND};
+        auto giantRange = [&](uint64_t from, uint64_t to) {
+            GF2mElement y = from == 0 ? h : h * stride.power(toBinary(from));
+            for (uint64_t i = from; i < to && answer.load(std::memory_order_relaxed) == NOT_FOUND; ++i) {
+                uint64_t j;
+                if (table.find(y.toWords(), j)) {
+                    uint64_t x = i * B + j;
+                    uint64_t expected = NOT_FOUND;
+                    if (x < order) answer.compare_exchange_strong(expected, x);
+                    return;
+                }
+                y = y * stride;
+            }
+        };
+        runSplit(giants, threads, giantRange);
+        return answer;
+    }
+
+    // x mod modulus with g^x = h; modulus is the part of the smooth order on which g's projection is nontrivial
+    static Result solve(const GF2mElement& g, const GF2mElement& h, int threads = 0) {
+        uint64_t log = 0;
+        uint64_t modulus = 1;
+        for (const Factor& f : smoothFactors()) {
+            uint64_t qe = 1;
+            for (int i = 0; i < f.exponent; ++i) qe *= f.prime;
+
+            GF2mElement gamma = g.power(cofactorExponent(f.prime));
+            if (gamma.isOne()) continue;
+
+            // digits of x mod q^e: x_k = d_0 + d_1 q + ... + d_(k-1) q^(k-1)
+            uint64_t x = 0;
+            uint64_t qk = 1;
+            bool solved = true;
+            for (int k = 0; k < f.exponent; ++k) {
+                GF2mElement shifted = x == 0 ? h : h * g.power(toBinary(x)).inverse();
+                GF2mElement hk = shifted.power(cofactorExponent(qk * f.prime));
+                uint64_t d = hk.isOne() ? 0 : babyStepGiantStep(gamma, hk, f.prime, threads);
+                if (d == NOT_FOUND) {
+                    solved = false;
+                    break;
+                }
+                x += d * qk;
+                qk *= f.prime;
+            }
+            if (!solved) continue;
+
+            // CRT: log = log mod modulus, x mod qe
+            uint64_t t = modn::mul(modn::sub(x % qe, log % qe, qe), modn::inverse(modulus % qe, qe), qe);
+            log += modulus * t;
+            modulus *= qe;
+        }
+        return {log, modulus};
+    }
+
+private:
+    template <typename Range>
+    static void runSplit(uint64_t total, int threads, Range range) {
+        uint64_t chunk = (total + threads - 1) / threads;
+        std::vector<std::thread> pool;
+        for (uint64_t from = 0; from < total; from += chunk) {
+            pool.emplace_back(range, from, std::min(total, from + chunk));
+        }
+        for (auto& th : pool) th.join();
+    }
+};
+
+#endif //LW4_POHLIGHELLMAN_H
@@ -0,0 +1,51 @@
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include "GF2mSmall.h"
+#include "PollardRho.h"
+
+template <int M>
+int run(int a, int threads, int dpBits, uint64_t seed, uint64_t maxIterations) {
+    using Field = GF2mSmall<M>;
+    KoblitzInstance<Field> instance = KoblitzInstance<Field>::create(a, seed);
+    std::cout << "Curve: y^2 + xy = x^3 + " << (a ? "x^2 + " : "") << "1 over GF(2^" << M << ")" << std::endl;
+    std::cout << "#E = " << instance.order << ", n = " << instance.n << ", lambda = " << instance.lambda << std::endl;
+
+    std::mt19937_64 rng(seed ^ 0x5DEECE66DULL);
+    uint64_t k = rng() % instance.n;
+    BinaryPoint<Field> Q = instance.curve.multiply(instance.G, k);
+
+    typename PollardRho<Field>::Settings settings;
+    settings.threads = threads;
+    settings.distinguishedBits = dpBits;
+    settings.maxIterations = maxIterations;
+    PollardRho<Field> rho(instance, settings);
+    auto result = rho.solve(Q, seed);
+
+    std::cout << "Secret k: " << k << std::endl;
+    std::cout << "Found k: " << (result.found ? std::to_string(result.log) : "-") << std::endl;
+    std::cout << "Iterations: " << result.iterations << ", distinguished points: " << result.distinguishedPoints
+              << ", fruitless cycles: " << result.fruitlessCycles << std::endl;
+    std::cout << "Time: " << result.seconds << " s, " << result.iterationsPerSecond << " iterations/s" << std::endl;
+    return result.found && result.log == k ? 0 : 1;
+}
+
+// usage: PollardRho [m = 23 | 41 | 53] [a] [threads] [distinguished bits] [seed] [max iterations, 0 = no limit]
+int main(int argc, char* argv[]) {
+    int m = argc > 1 ? std::atoi(argv[1]) : 41;
+    int a = argc > 2 ? std::atoi(argv[2]) : 0;
+    int threads = argc > 3 ? std::atoi(argv[3]) : static_cast<int>(std::thread::hardware_concurrency());
+    int dpBits = argc > 4 ? std::atoi(argv[4]) : 8;
+    uint64_t seed = argc > 5 ? std::strtoull(argv[5], nullptr, 10) : std::random_device{}();
+    uint64_t maxIterations = argc > 6 ? std::strtoull(argv[6], nullptr, 10) : 0;
+
+    switch (m) {
+        case 23: return run<23>(a, threads, dpBits, seed, maxIterations);
+        case 41: return run<41>(a, threads, dpBits, seed, maxIterations);
+        case 53: return run<53>(a, threads, dpBits, seed, maxIterations);
+        default:
+            std::cerr << "Unsupported m = " << m << " (toy sizes with a type II ONB: 23, 41, 53)" << std::endl;
+            return 1;
+    }
+}
@@ -0,0 +1,329 @@
+#ifndef LW4_POLLARDRHO_H
+#define LW4_POLLARDRHO_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "BinaryCurve.h"
+#include "GF2mTower.h"
+#include "ModArithmetic.h"
+
+// Koblitz curve y^2 + xy = x^3 + a x^2 + 1 over a toy GF2mSmall<M> (M odd), restricted to the subgroup
+// of the largest prime factor n of its order, with the Frobenius eigenvalue tau(P) = lambda * P on it.
+template <typename Field>
+struct KoblitzInstance {
+    BinaryCurve<Field> curve;
+    BinaryPoint<Field> G;
+    uint64_t order;
+    uint64_t n;
+    uint64_t lambda;
+
+    static KoblitzInstance create(int a, uint64_t seed) {
+        const int M = Field::getM();
+        int64_t mu = a ? 1 : -1;
+        // #E(GF(2^M)) = 2^M + 1 - V_M with V_0 = 2, V_1 = mu, V_k = mu V_(k-1) - 2 V_(k-2)
+        int64_t v0 = 2, v1 = mu;
+        for (int k = 2; k <= M; ++k) {
+            int64_t v2 = mu * v1 - 2 * v0;
+            v0 = v1;
+            v1 = v2;
+        }
+        uint64_t order = (uint64_t(1) << M) + 1 - v1;
+
+        uint64_t n = order;
+        for (uint64_t q = 2; q * q <= n; ++q) {
+            if (modn::isPrime(n)) break;
+            while (n % q == 0 && n != q) n /= q;
+        }
+        uint64_t cofactor = order / n;
+
+        BinaryCurve<Field> curve = BinaryCurve<Field>::koblitz(a);
+        std::mt19937_64 rng(seed);
+        BinaryPoint<Field> G;
+        while (G.infinity) {
+            BinaryPoint<Field> P;
+            if (curve.liftX(Field(rng()), P)) {
+                G = curve.multiply(P, cofactor);
+            }
+        }
+
+        // lambda^2 - mu lambda + 2 = 0 mod n
+        uint64_t root = modn::sqrt(modn::sub(0, 7 % n, n), n);
+        uint64_t half = modn::inverse(2, n);
+        uint64_t mu_n = a ? 1 : n - 1;
+        uint64_t lambda = modn::mul(modn::add(mu_n, root, n), half, n);
+        BinaryPoint<Field> tauG = curve.frobenius(G);
+        BinaryPoint<Field> lambdaG = curve.multiply(G, lambda);
+        if (!(tauG.x + lambdaG.x).isZero() || !(tauG.y + lambdaG.y).isZero()) {
+            lambda = modn::mul(modn::sub(mu_n, root, n), half, n);
+        }
+
+        return KoblitzInstance{curve, G, order, n, lambda};
+    }
+};
+
+// Parallel Pollard rho for Q = k G with r-adding walks on classes {+-tau^i(X)}, distinguished points
+// shared across threads, and one batched inversion per step for all walks of a thread.
+template <typename Field>
+class PollardRho {
+public:
+    struct Settings {
+        int threads = 1;
+        int walksPerThread = 64;
+        int distinguishedBits = 8;
+        int partitions = 32;
+        bool useFrobenius = true;
+        bool useNegation = true;
+        // steps over all threads (checked per round of walksPerThread) before giving up with found = false;
+        // 0 for no limit
+        uint64_t maxIterations = 0;
+    };
+
+    struct Result {
+        bool found = false;
+        uint64_t log = 0;
+        uint64_t iterations = 0;
+        uint64_t distinguishedPoints = 0;
+        uint64_t fruitlessCycles = 0;
+        double seconds = 0;
+        double iterationsPerSecond = 0;
+    };
+
+private:
+    struct Walk {
+        BinaryPoint<Field> X;
+        uint64_t c;
+        uint64_t d;
+        uint64_t previousX;
+        uint64_t length;
+    };
+
+    struct Distinguished {
+        uint64_t y;
+        uint64_t c;
+        uint64_t d;
+    };
+
+    const KoblitzInstance<Field>& instance;
+    Settings settings;
+    BinaryPoint<Field> Q;
+    std::vector<BinaryPoint<Field>> steps;
+    std::vector<uint64_t> stepC;
+    std::vector<uint64_t> stepD;
+    std::vector<uint64_t> lambdaPowers;
+
+    std::mutex tableMutex;
+    std::unordered_map<uint64_t, Distinguished> table;
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> fruitless{0};
+    std::atomic<uint64_t> started{0};
+    uint64_t answer = 0;
+
+    static bool samePoint(const BinaryPoint<Field>& P, const BinaryPoint<Field>& R) {
+        if (P.infinity || R.infinity) return P.infinity == R.infinity;
+        return (P.x + R.x).isZero() && (P.y + R.y).isZero();
+    }
+
+    int partition(uint64_t x) const {
+        return static_cast<int>((x * 0x9E3779B97F4A7C15ULL) >> 58) % settings.partitions;
+    }
+
+    // hashed rather than on raw low bits: the minimal rotation of x is almost always odd
+    bool isDistinguished(uint64_t x) const {
+        uint64_t mask = (uint64_t(1) << settings.distinguishedBits) - 1;
+        return ((x * 0xD6E8FEB86659FD93ULL) >> 40 & mask) == 0;
+    }
+
+    // representative of {+-tau^i(X)}: the rotation with the smallest x word, then the smaller of y, x + y
+    void canonicalize(Walk& w) const {
+        const uint64_t n = instance.n;
+        if (settings.useFrobenius) {
+            const int M = Field::getM();
+            uint64_t best = w.X.x.getBits();
+            int best_i = 0;
+            for (int i = 1; i < M; ++i) {
+                uint64_t candidate = w.X.x.frobenius(i).getBits();
+                if (candidate < best) {
+                    best = candidate;
+                    best_i = i;
+                }
+            }
+            if (best_i) {
+                w.X = instance.curve.frobenius(w.X, best_i);
+                w.c = modn::mul(w.c, lambdaPowers[best_i], n);
+                w.d = modn::mul(w.d, lambdaPowers[best_i], n);
+            }
+        }
+        if (settings.useNegation) {
+            Field negY = w.X.x + w.X.y;
+            if (negY.getBits() < w.X.y.getBits()) {
+                w.X.y = negY;
+                w.c = modn::sub(0, w.c, n);
+                w.d = modn::sub(0, w.d, n);
+            }
+        }
+    }
+
+    void restart(Walk& w, std::mt19937_64& rng) const {
+        const uint64_t n = instance.n;
+        do {
+            w.c = rng() % n;
+            w.d = rng() % n;
+            w.X = instance.curve.add(instance.curve.multiply(instance.G, w.c), instance.curve.multiply(Q, w.d));
+        } while (w.X.infinity);
+        canonicalize(w);
+        w.previousX = ~uint64_t(0);
+        w.length = 0;
+    }
+
+    // on a DP collision c1 + d1 k = c2 + d2 k, or c1 + d1 k = -(c2 + d2 k) if the y-coordinates disagree
+    bool tryCollision(const Walk& w, const Distinguished& other) {
+        const uint64_t n = instance.n;
+        uint64_t c2 = other.c, d2 = other.d;
+        if (other.y != w.X.y.getBits()) {
+            c2 = modn::sub(0, c2, n);
+            d2 = modn::sub(0, d2, n);
+        }
+        if (w.d == d2) return false;
+        uint64_t k = modn::mul(modn::sub(c2, w.c, n), modn::inverse(modn::sub(w.d, d2, n), n), n);
+        if (!samePoint(instance.curve.multiply(instance.G, k), Q)) return false;
+        answer = k;
+        return true;
+    }
+
+    void worker(int id, uint64_t seed, uint64_t& iterations, uint64_t& distinguished) {
+        std::mt19937_64 rng(seed + 0x9E3779B97F4A7C15ULL * (id + 1));
+        const uint64_t n = instance.n;
+        const uint64_t maxLength = uint64_t(20) << settings.distinguishedBits;
+
+        std::vector<Walk> walks(settings.walksPerThread);
+        for (Walk& w : walks) restart(w, rng);
+
+        std::vector<Field> denominators(walks.size());
+        std::vector<int> targets(walks.size());
+
+        while (!done.load(std::memory_order_relaxed)) {
+            // each round claims its steps from the shared budget, so a target outside <G> cannot run forever
+            if (settings.maxIterations &&
+                started.fetch_add(walks.size(), std::memory_order_relaxed) >= settings.maxIterations) {
+                break;
+            }
+            for (size_t i = 0; i < walks.size(); ++i) {
+                targets[i] = partition(walks[i].X.x.getBits());
+                denominators[i] = walks[i].X.x + steps[targets[i]].x;
+            }
+            batchInverse(denominators);
+
+            for (size_t i = 0; i < walks.size(); ++i) {
+                Walk& w = walks[i];
+                const BinaryPoint<Field>& R = steps[targets[i]];
+                if (denominators[i].isZero()) {
+                    restart(w, rng);
+                    continue;
+                }
+                Walk previous = w;
+                w.X = instance.curve.addWithInverse(w.X, R, denominators[i]);
+                w.c = modn::add(w.c, stepC[targets[i]], n);
+                w.d = modn::add(w.d, stepD[targets[i]], n);
+                canonicalize(w);
+                w.previousX = previous.X.x.getBits();
+                ++w.length;
+
+                // fruitless 2-cycle {A, B}: leave it deterministically by doubling the one with smaller x
+                if (w.X.x.getBits() == previous.previousX) {
+                    fruitless.fetch_add(1, std::memory_order_relaxed);
+                    if (previous.X.x.getBits() < w.X.x.getBits()) {
+                        w.X = previous.X;
+                        w.c = previous.c;
+                        w.d = previous.d;
+                    }
+                    w.X = instance.curve.doublePoint(w.X);
+                    w.c = modn::add(w.c, w.c, n);
+                    w.d = modn::add(w.d, w.d, n);
+                    if (w.X.infinity) {
+                        restart(w, rng);
+                        continue;
+                    }
+                    canonicalize(w);
+                }
+
+                if (isDistinguished(w.X.x.getBits())) {
+                    ++distinguished;
+                    std::lock_guard<std::mutex> lock(tableMutex);
+                    auto it = table.find(w.X.x.getBits());
+                    if (it == table.end()) {
+                        table.emplace(w.X.x.getBits(), Distinguished{w.X.y.getBits(), w.c, w.d});
+                    } else if (!done && tryCollision(w, it->second)) {
+                        done = true;
+                    }
+                    restart(w, rng);
+                } else if (w.length > maxLength) {
+                    restart(w, rng);
+                }
+            }
+            iterations += walks.size();
+        }
+    }
+
+public:
+    PollardRho(const KoblitzInstance<Field>& instance, const Settings& settings)
+            : instance(instance), settings(settings) {
+        lambdaPowers.resize(Field::getM());
+        lambdaPowers[0] = 1;
+        for (int i = 1; i < Field::getM(); ++i) {
+            lambdaPowers[i] = modn::mul(lambdaPowers[i - 1], instance.lambda, instance.n);
+        }
+    }
+
+    Result solve(const BinaryPoint<Field>& target, uint64_t seed) {
+        const uint64_t n = instance.n;
+        Q = target;
+        table.clear();
+        done = false;
+        fruitless = 0;
+        started = 0;
+
+        std::mt19937_64 rng(seed);
+        steps.clear();
+        stepC.clear();
+        stepD.clear();
+        while (static_cast<int>(steps.size()) < settings.partitions) {
+            uint64_t c = rng() % n, d = rng() % n;
+            BinaryPoint<Field> R = instance.curve.add(instance.curve.multiply(instance.G, c), instance.curve.multiply(Q, d));
+            if (R.infinity) continue;
+            steps.push_back(R);
+            stepC.push_back(c);
+            stepD.push_back(d);
+        }
+
+        int threads = std::max(1, settings.threads);
+        std::vector<uint64_t> iterations(threads, 0), distinguished(threads, 0);
+        auto start = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; ++t) {
+            pool.emplace_back(&PollardRho::worker, this, t, seed, std::ref(iterations[t]), std::ref(distinguished[t]));
+        }
+        for (auto& th : pool) th.join();
+        auto stop = std::chrono::high_resolution_clock::now();
+
+        Result result;
+        result.found = done;
+        result.log = answer;
+        for (int t = 0; t < threads; ++t) {
+            result.iterations += iterations[t];
+            result.distinguishedPoints += distinguished[t];
+        }
+        result.fruitlessCycles = fruitless;
+        result.seconds = std::chrono::duration<double>(stop - start).count();
+        result.iterationsPerSecond = result.seconds > 0 ? result.iterations / result.seconds : 0;
+        return result;
+    }
+};
+
+#endif //LW4_POLLARDRHO_H
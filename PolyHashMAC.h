@@ -0,0 +1,250 @@
+#ifndef LW4_POLYHASHMAC_H
+#define LW4_POLYHASHMAC_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "GF2mElement.h"
+
+// Multiplication by a fixed element in packed form: the product is GF(2)-linear in the other operand,
+// so it is a XOR of one precomputed image per byte (30 lookups into 240 KB, no bit-serial multiply).
+class FixedMultiplier {
+public:
+    using Words = std::array<uint64_t, 4>;
+
+private:
+    static const int BYTES = 30;
+    std::vector<Words> table;
+
+public:
+    explicit FixedMultiplier(const GF2mElement& h) : table(BYTES * 256, Words{}) {
+        const int m = GF2mElement::getM();
+        // image of packed bit b, i.e. of coefficients[b] = beta^(2^(m - 1 - b))
+        std::vector<Words> columns(BYTES * 8, Words{});
+        for (int b = 0; b < m; ++b) {
+            columns[b] = h.multiplyByBasisElement(m - 1 - b).toWords();
+        }
+        for (int byte = 0; byte < BYTES; ++byte) {
+            for (int v = 1; v < 256; ++v) {
+                Words& entry = table[byte * 256 + v];
+                for (int bit = 0; bit < 8; ++bit) {
+                    if (!((v >> bit) & 1)) continue;
+                    for (int w = 0; w < 4; ++w) entry[w] ^= columns[byte * 8 + bit][w];
+                }
+            }
+        }
+    }
+
+    Words multiply(const Words& x) const {
+        Words result{};
+        const Words* row = table.data();
+        for (int w = 0; w < 4; ++w) {
+            uint64_t word = x[w];
+            int bytes = (w == 3) ? BYTES - 24 : 8;
+            for (int i = 0; i < bytes; ++i, row += 256) {
+                const Words& entry = row[(word >> (8 * i)) & 255];
+                result[0] ^= entry[0];
+                result[1] ^= entry[1];
+                result[2] ^= entry[2];
+                result[3] ^= entry[3];
+            }
+        }
+        return result;
+    }
+};
+
+// Streaming polynomial-evaluation MAC over GF(2^233): the input is cut into 29-byte (232-bit) blocks
+// M_1..M_L, followed by a block holding the bit length, and
+//   hash = sum M_i H^(L - i + 1),   tag = hash + mask.
+// Block i goes to lane i mod k and every lane runs its own Horner chain with the same multiplier H^k;
+// the lanes are folded together with H^k, ..., H^1 at the end. Full blocks are read in place from the
+// caller's buffer, only a trailing partial block is copied. For Wegman-Carter security the mask must be
+// a fresh one-time value per message (e.g. a PRF of the nonce).
+class PolyHashMAC {
+public:
+    using Words = FixedMultiplier::Words;
+    static const size_t BLOCK_BYTES = 29;
+
+private:
+    GF2mElement key;
+    // powers[j] multiplies by H^(j + 1); shared between copies, so per-thread workers are cheap
+    std::shared_ptr<const std::vector<FixedMultiplier>> powers;
+    int lanes;
+
+    std::vector<Words> accumulators;
+    size_t blocksInGroup = 0;
+    uint64_t totalBytes = 0;
+    uint8_t pending[BLOCK_BYTES] = {};
+    size_t pendingBytes = 0;
+
+    static Words loadBlock(const uint8_t* data, size_t length) {
+        Words block{};
+        std::memcpy(block.data(), data, length);
+        return block;
+    }
+
+    void absorb(const Words& block) {
+        Words& acc = accumulators[blocksInGroup];
+        Words product = (*powers)[lanes - 1].multiply(acc);
+        for (int w = 0; w < 4; ++w) acc[w] = product[w] ^ block[w];
+        if (++blocksInGroup == static_cast<size_t>(lanes)) blocksInGroup = 0;
+    }
+
+    // the k lanes kept in lockstep over whole groups, so the hot loop has no lane bookkeeping
+    void absorbGroups(const uint8_t* data, size_t groups) {
+        for (size_t g = 0; g < groups; ++g) {
+            for (int j = 0; j < lanes; ++j, data += BLOCK_BYTES) {
+                Words& acc = accumulators[j];
+                Words product = (*powers)[lanes - 1].multiply(acc);
+                Words block = loadBlock(data, BLOCK_BYTES);
+                for (int w = 0; w < 4; ++w) acc[w] = product[w] ^ block[w];
+            }
+        }
+    }
+
+    // Horner value of the full blocks absorbed so far: lane j is multiplied by H^shift, where shift is
+    // the distance from its last block to the end of the stream
+    Words foldLanes() const {
+        Words hash{};
+        int inGroup = static_cast<int>(blocksInGroup);
+        for (int j = 0; j < lanes; ++j) {
+            int shift = (j < inGroup ? inGroup : inGroup + lanes) - j;
+            Words product = (*powers)[shift - 1].multiply(accumulators[j]);
+            for (int w = 0; w < 4; ++w) hash[w] ^= product[w];
+        }
+        return hash;
+    }
+
+    // Horner steps for the zero-padded trailing block and the length block, then reset()
+    Words finish(Words hash) {
+        if (pendingBytes) {
+            std::memset(pending + pendingBytes, 0, BLOCK_BYTES - pendingBytes);
+            Words block = loadBlock(pending, BLOCK_BYTES);
+            for (int w = 0; w < 4; ++w) hash[w] ^= block[w];
+            hash = (*powers)[0].multiply(hash);
+        }
+        Words lengthBlock{totalBytes * 8, 0, 0, 0};
+        for (int w = 0; w < 4; ++w) hash[w] ^= lengthBlock[w];
+        hash = (*powers)[0].multiply(hash);
+        reset();
+        return hash;
+    }
+
+    static std::string toBinary(uint64_t value) {
+        std::string bits;
+        for (int i = 63; i >= 0; --i) {
+            if (!bits.empty() || ((value >> i) & 1)) bits.push_back(((value >> i) & 1) ? '1' : '0');
+        }
+        return bits.empty() ? "0" : bits;
+    }
+
+public:
+    explicit PolyHashMAC(const GF2mElement& key, int lanes = 8) : key(key), lanes(lanes < 1 ? 1 : lanes) {
+        auto table = std::make_shared<std::vector<FixedMultiplier>>();
+        GF2mElement power = key;
+        for (int j = 0; j < this->lanes; ++j) {
+            table->emplace_back(power);
+            if (j + 1 < this->lanes) power = power * key;
+        }
+        powers = table;
+        reset();
+    }
+
+    void reset() {
+        accumulators.assign(lanes, Words{});
+        blocksInGroup = 0;
+        totalBytes = 0;
+        pendingBytes = 0;
+    }
+
+    void update(const uint8_t* data, size_t length) {
+        totalBytes += length;
+        if (pendingBytes) {
+            size_t take = std::min(length, BLOCK_BYTES - pendingBytes);
+            std::memcpy(pending + pendingBytes, data, take);
+            pendingBytes += take;
+            data += take;
+            length -= take;
+            if (pendingBytes < BLOCK_BYTES) return;
+            absorb(loadBlock(pending, BLOCK_BYTES));
+            pendingBytes = 0;
+        }
+        while (blocksInGroup && length >= BLOCK_BYTES) {
+            absorb(loadBlock(data, BLOCK_BYTES));
+            data += BLOCK_BYTES;
+            length -= BLOCK_BYTES;
+        }
+        size_t groups = length / (BLOCK_BYTES * lanes);
+        absorbGroups(data, groups);
+        data += groups * BLOCK_BYTES * lanes;
+        length -= groups * BLOCK_BYTES * lanes;
+        while (length >= BLOCK_BYTES) {
+            absorb(loadBlock(data, BLOCK_BYTES));
+            data += BLOCK_BYTES;
+            length -= BLOCK_BYTES;
+        }
+        std::memcpy(pending, data, length);
+        pendingBytes = length;
+    }
+
+    // the polynomial hash of everything absorbed so far; the object is left ready for a new message
+    GF2mElement digest() {
+        return GF2mElement::fromWords(finish(foldLanes()));
+    }
+
+    // same value as reset(), update(data, length), digest(), with the full blocks split into one contiguous
+    // chunk per thread; chunk c is shifted into place with H^(number of blocks after it)
+    GF2mElement digestParallel(const uint8_t* data, size_t length, int threads = 0) {
+        if (threads <= 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        size_t blocks = length / BLOCK_BYTES;
+        size_t chunk = (blocks + threads - 1) / threads;
+        reset();
+        if (threads == 1 || chunk < 4096) {
+            update(data, length);
+            return digest();
+        }
+
+        std::vector<Words> partial(threads, Words{});
+        std::vector<std::thread> pool;
+        for (int c = 0; c < threads; ++c) {
+            size_t from = c * chunk, to = std::min(blocks, from + chunk);
+            if (from >= to) break;
+            pool.emplace_back([&, c, from, to] {
+                PolyHashMAC worker(*this);
+                worker.update(data + from * BLOCK_BYTES, (to - from) * BLOCK_BYTES);
+                Words h = worker.foldLanes();
+                if (to < blocks) {
+                    h = (GF2mElement::fromWords(h) * key.power(toBinary(blocks - to))).toWords();
+                }
+                partial[c] = h;
+            });
+        }
+        for (auto& th : pool) th.join();
+
+        Words hash{};
+        for (const Words& h : partial) {
+            for (int w = 0; w < 4; ++w) hash[w] ^= h[w];
+        }
+        totalBytes = length;
+        pendingBytes = length - blocks * BLOCK_BYTES;
+        if (pendingBytes) std::memcpy(pending, data + blocks * BLOCK_BYTES, pendingBytes);
+        return GF2mElement::fromWords(finish(hash));
+    }
+
+    GF2mElement finalize(const GF2mElement& mask) {
+        return digest() + mask;
+    }
+
+    GF2mElement mac(const uint8_t* data, size_t length, const GF2mElement& mask) {
+        reset();
+        update(data, length);
+        return finalize(mask);
+    }
+};
+
+#endif //LW4_POLYHASHMAC_H
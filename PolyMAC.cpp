@@ -0,0 +1,77 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "PolyHashMAC.h"
+
+// usage: PolyMAC <file> <key bit string> [mask bit string] [lanes] [threads]
+//        PolyMAC                                  (throughput benchmark on a 256 MB buffer)
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        std::mt19937_64 rng(233);
+        GF2mElement key = GF2mElement::fromWords({rng(), rng(), rng(), rng()});
+        std::vector<uint8_t> buffer(size_t(256) << 20);
+        for (auto& byte : buffer) byte = static_cast<uint8_t>(rng());
+
+        for (int lanes : {1, 4, 8}) {
+            PolyHashMAC mac(key, lanes);
+            auto start = std::chrono::high_resolution_clock::now();
+            mac.digestParallel(buffer.data(), buffer.size(), 1);
+            auto stop = std::chrono::high_resolution_clock::now();
+            double seconds = std::chrono::duration<double>(stop - start).count();
+            std::cout << lanes << " lanes, 1 thread: " << buffer.size() / seconds / 1e9 << " GB/s" << std::endl;
+        }
+        PolyHashMAC mac(key, 8);
+        auto start = std::chrono::high_resolution_clock::now();
+        mac.digestParallel(buffer.data(), buffer.size());
+        auto stop = std::chrono::high_resolution_clock::now();
+        double seconds = std::chrono::duration<double>(stop - start).count();
+        std::cout << "8 lanes, all threads: " << buffer.size() / seconds / 1e9 << " GB/s" << std::endl;
+        return 0;
+    }
+
+    GF2mElement key{std::string(argv[2])};
+    GF2mElement mask = argc > 3 ? GF2mElement(std::string(argv[3])) : GF2mElement::zero();
+    int lanes = argc > 4 ? std::atoi(argv[4]) : 8;
+    int threads = argc > 5 ? std::atoi(argv[5]) : 0;
+
+    int fd = open(argv[1], O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Cannot open " << argv[1] << std::endl;
+        return 1;
+    }
+    struct stat st{};
+    fstat(fd, &st);
+    size_t length = static_cast<size_t>(st.st_size);
+    const uint8_t* data = nullptr;
+    void* mapped = MAP_FAILED;
+    if (length > 0) {
+        mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped == MAP_FAILED) {
+            std::cerr << "Cannot map " << argv[1] << std::endl;
+            close(fd);
+            return 1;
+        }
+        madvise(mapped, length, MADV_SEQUENTIAL);
+        data = static_cast<const uint8_t*>(mapped);
+    }
+
+    PolyHashMAC mac(key, lanes);
+    auto start = std::chrono::high_resolution_clock::now();
+    GF2mElement tag = mac.digestParallel(data, length, threads) + mask;
+    auto stop = std::chrono::high_resolution_clock::now();
+    double seconds = std::chrono::duration<double>(stop - start).count();
+
+    if (mapped != MAP_FAILED) munmap(mapped, length);
+    close(fd);
+
+    std::cout << "Tag: " << tag << std::endl;
+    std::cout << "Time: " << seconds << " s, " << (seconds > 0 ? length / seconds / 1e9 : 0) << " GB/s" << std::endl;
+    return 0;
+}
@@ -0,0 +1,352 @@
+#ifndef LW4_SCALABILITYBENCHMARK_H
+#define LW4_SCALABILITYBENCHMARK_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "BinaryEdwards.h"
+#include "ChaCha20Random.h"
+#include "CheckedMultiplier.h"
+#include "EnergyMeter.h"
+#include "ForkJoinGroup.h"
+#include "GF2mBitsliced.h"
+#include "GF2mDoubled.h"
+#include "GF2mElement.h"
+#include "GF2mPalindromic.h"
+#include "KoblitzCurve.h"
+
+// one measured point of the sweep; speedup and efficiency are against the same backend and batch on one thread.
+// The energy fields are only set (energy = true) when the RAPL counters could be read.
+struct BenchmarkResult {
+    std::string backend;
+    std::string operation;
+    int threads;
+    size_t batch;
+    double seconds;
+    uint64_t ops;
+    double opsPerSecond;
+    double speedup;
+    double efficiency;
+    double bytesPerSecond;
+    bool energy;
+    double joules;
+    double joulesPerOp;
+    double opsPerJoule;
+};
+
+// Throughput of every multiplication and inversion backend, random element generation, exponentiation and the
+// curve scalar multiplications over thread counts and batch sizes, on operands from a ChaCha20 generator seeded
+// with seed. A pass applies the operation to all batch elements, each thread of a ForkJoinGroup taking a
+// contiguous slice; passes repeat until the point has run for at least minSeconds.
+// Backends too slow for a batch size (maxBatch) are skipped there. The package and DRAM energy read around the
+// passes gives joules per operation; it covers the whole machine, so other load on the host is charged too.
+class ScalabilityBenchmark {
+public:
+    using Words = std::array<uint64_t, 4>;
+
+    struct Backend {
+        std::string name;
+        std::string operation;
+        size_t maxBatch;
+        size_t bytesPerOp; // operand and result bytes touched per operation
+        std::function<void(size_t, size_t)> run; // elements [from, to)
+    };
+
+private:
+    size_t capacity;
+    std::vector<Words> a, b, c;
+    std::vector<Words> palindromicA, palindromicB, palindromicC;
+    std::vector<GF2mElement> elementsA, elementsB, elementsC;
+    std::vector<GF2mDoubled> doubledA, doubledB, doubledC;
+    std::vector<Backend> backends;
+    EnergyMeter meter;
+
+    // K-233 points of order n with 232-bit scalars, and their Edwards w-coordinates, for the curve backends
+    static const size_t CURVE_POINTS = 64;
+    std::string exponent;
+    KoblitzCurve<GF2mElement> koblitz{0};
+    BinaryEdwardsCurve<GF2mElement> edwards{GF2mElement::one(), GF2mElement::one()};
+    std::vector<BinaryPoint<GF2mElement>> points, products;
+    std::vector<GF2mElement> ws, wProducts;
+    std::vector<std::string> scalars;
+
+    static Words random(std::mt19937_64& rng) {
+        Words w{rng(), rng(), rng(), rng()};
+        w[3] &= (uint64_t(1) << (GF2mElement::getM() - 192)) - 1;
+        return w;
+    }
+
+    void addBackends() {
+        const size_t words = 3 * sizeof(Words);
+        backends.push_back({"element", "multiply", capacity, words, [this](size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) elementsC[i] = elementsA[i] * elementsB[i];
+        }});
+        backends.push_back({"palindromic-comb", "multiply", capacity, words, [this](size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) c[i] = PalindromicMultiplier::multiply(a[i], b[i], PalindromicMultiplier::COMB);
+        }});
+        if (PalindromicMultiplier::kernel() == PalindromicMultiplier::CLMUL) {
+            backends.push_back({"palindromic-clmul", "multiply", capacity, words, [this](size_t from, size_t to) {
+                for (size_t i = from; i < to; ++i) c[i] = PalindromicMultiplier::multiply(a[i], b[i], PalindromicMultiplier::CLMUL);
+            }});
+        }
+        // operands kept in palindromic form, so no coordinate permutation per product
+        backends.push_back({"palindromic-native", "multiply", capacity, words, [this](size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) {
+                palindromicC[i] = PalindromicMultiplier::multiplyPalindromic(palindromicA[i], palindromicB[i],
+                                                                               PalindromicMultiplier::kernel());
+            }
+        }});
+        // fault detection overhead: the parity prediction alone, and with the rotated recomputation
+        backends.push_back({"checked-parity", "multiply", capacity, words, [this](size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) CheckedMultiplier::multiply(a[i], b[i], c[i], CheckedMultiplier::PARITY);
+        }});
+        backends.push_back({"checked-rotated", "multiply", capacity, words, [this](size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) CheckedMultiplier::multiply(a[i], b[i], c[i], CheckedMultiplier::ROTATED);
+        }});
+        backends.push_back({"checked-native-parity", "multiply", capacity, words, [this](size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) {
+                CheckedMultiplier::multiplyPalindromic(palindromicA[i], palindromicB[i], palindromicC[i]);
+            }
+        }});
+        backends.push_back({"doubled", "multiply", capacity, 2 * words, [this](size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) doubledC[i] = doubledA[i] * doubledB[i];
+        }});
+        // 64 products per bitsliced multiplication, including the transposes in and out
+        backends.push_back({"bitsliced", "multiply", capacity, words, [this](size_t from, size_t to) {
+            for (size_t i = from; i < to; i += GF2mBitsliced::LANES) {
+                size_t n = std::min<size_t>(GF2mBitsliced::LANES, to - i);
+                std::array<Words, GF2mBitsliced::LANES> x{}, y{};
+                std::copy(a.begin() + i, a.begin() + i + n, x.begin());
+                std::copy(b.begin() + i, b.begin() + i + n, y.begin());
+                auto z = (GF2mBitsliced::pack(x) * GF2mBitsliced::pack(y)).unpack();
+                std::copy(z.begin(), z.begin() + n, c.begin() + i);
+            }
+        }});
+        backends.push_back({"massey-omura-serial", "multiply", std::min<size_t>(capacity, 100), words,
+                            [this](size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) {
+                GF2mElement::multiplyAndShift(elementsA[i], elementsB[i], GF2mElement::getM());
+            }
+        }});
+        backends.push_back({"itoh-tsujii", "inverse", std::min<size_t>(capacity, 10000), 2 * sizeof(Words),
+                            [this](size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) elementsC[i] = elementsA[i].inverse();
+        }});
+        // Montgomery's trick over the slice: one inversion and three products per element
+        backends.push_back({"batch-inverse", "inverse", capacity, 3 * sizeof(Words), [this](size_t from, size_t to) {
+            if (from == to) return;
+            const auto k = PalindromicMultiplier::kernel();
+            c[from] = a[from];
+            for (size_t i = from + 1; i < to; ++i) c[i] = PalindromicMultiplier::multiply(c[i - 1], a[i], k);
+            Words inv = GF2mElement::fromWords(c[to - 1]).inverse().toWords();
+            for (size_t i = to - 1; i > from; --i) {
+                Words next = PalindromicMultiplier::multiply(inv, a[i], k);
+                c[i] = PalindromicMultiplier::multiply(inv, c[i - 1], k);
+                inv = next;
+            }
+            c[from] = inv;
+        }});
+        // uniform elements from each thread's ChaCha20 generator, and through the bit-string constructor
+        backends.push_back({"chacha20", "random", capacity, sizeof(Words), [this](size_t from, size_t to) {
+            ChaCha20Random::local().fillElements(c.data() + from, to - from);
+        }});
+        backends.push_back({"bit-string", "random", std::min<size_t>(capacity, 10000), sizeof(Words),
+                            [this](size_t from, size_t to) {
+            ChaCha20Random& generator = ChaCha20Random::local();
+            for (size_t i = from; i < to; ++i) {
+                std::string bits;
+                for (int j = 0; j < GF2mElement::getM(); ++j) bits.push_back(generator.next() & 1 ? '1' : '0');
+                elementsC[i] = GF2mElement(bits);
+            }
+        }});
+        backends.push_back({"element", "power", std::min<size_t>(capacity, 1000), 2 * sizeof(Words),
+                            [this](size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) elementsC[i] = elementsA[i].power(exponent);
+        }});
+
+        const size_t curve = points.size();
+        const size_t pointBytes = 2 * sizeof(Words);
+        backends.push_back({"k233-double-and-add", "scalar-multiply", std::min<size_t>(curve, 1), pointBytes,
+                            [this](size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) products[i] = koblitz.getCurve().multiply(points[i], scalars[i]);
+        }});
+        backends.push_back({"k233-tnaf", "scalar-multiply", std::min<size_t>(curve, 10), pointBytes,
+                            [this](size_t from, size_t to) {
+            for (size_t i = from; i < to; ++i) products[i] = koblitz.multiply(points[i], scalars[i]);
+        }});
+        // 64 ladders per bitsliced run, whatever the slice holds
+        backends.push_back({"edwards-bitsliced-ladder", "scalar-multiply", curve, sizeof(Words),
+                            [this](size_t from, size_t to) {
+            if (from == to) return;
+            std::vector<GF2mElement> out = edwards.batchLadder(
+                    std::vector<GF2mElement>(ws.begin() + from, ws.begin() + to),
+                    std::vector<std::string>(scalars.begin() + from, scalars.begin() + to));
+            std::copy(out.begin(), out.end(), wProducts.begin() + from);
+        }});
+    }
+
+    void addCurvePoints(std::mt19937_64& rng) {
+        const BinaryCurve<GF2mElement>& k233 = koblitz.getCurve();
+        BinaryEdwardsCurve<GF2mElement>::fromWeierstrassCurve(k233, GF2mElement::fromWords(random(rng)), edwards);
+        size_t count = std::min(capacity, CURVE_POINTS);
+        while (points.size() < count) {
+            BinaryPoint<GF2mElement> P;
+            if (!k233.liftX(GF2mElement::fromWords(random(rng)), P)) continue;
+            P = k233.multiply(P, uint64_t(4));
+            EdwardsPoint<GF2mElement> E = edwards.fromWeierstrass(P);
+            points.push_back(P);
+            ws.push_back(E.x + E.y);
+            std::string k;
+            for (int i = 0; i < 232; ++i) k.push_back(rng() & 1 ? '1' : '0');
+            scalars.push_back(k);
+        }
+        products.resize(count);
+        wProducts.assign(count, GF2mElement::zero());
+    }
+
+    // passes over the first batch elements on the group until minSeconds have passed
+    BenchmarkResult measure(const Backend& backend, ForkJoinGroup& group, size_t batch, double minSeconds) const {
+        const int threads = group.getSize();
+        auto pass = [&] {
+            group.run([&](int index) {
+                size_t from = batch * index / threads, to = batch * (index + 1) / threads;
+                backend.run(from, to);
+            });
+        };
+        pass(); // warm-up: caches, lazily built tables, worker wake-up
+        uint64_t passes = 0;
+        double seconds = 0;
+        std::vector<uint64_t> energyStart = meter.read();
+        auto start = std::chrono::steady_clock::now();
+        do {
+            pass();
+            ++passes;
+            seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (seconds < minSeconds);
+        std::vector<uint64_t> energyStop = meter.read();
+
+        BenchmarkResult result;
+        result.backend = backend.name;
+        result.operation = backend.operation;
+        result.threads = threads;
+        result.batch = batch;
+        result.seconds = seconds;
+        result.ops = passes * batch;
+        result.opsPerSecond = result.ops / seconds;
+        result.speedup = 1;
+        result.efficiency = 1;
+        result.bytesPerSecond = result.opsPerSecond * backend.bytesPerOp;
+        result.energy = meter.available();
+        result.joules = result.energy ? meter.joules(energyStart, energyStop) : 0;
+        result.joulesPerOp = result.joules / result.ops;
+        result.opsPerJoule = result.joules > 0 ? result.ops / result.joules : 0;
+        return result;
+    }
+
+public:
+    explicit ScalabilityBenchmark(size_t capacity, const EnergyMeter& meter = EnergyMeter(), uint64_t seed = 233)
+        : capacity(std::max<size_t>(1, capacity)), meter(meter) {
+        std::mt19937_64 rng(seed);
+        ChaCha20Random generator(seed);
+        a = generator.elements(this->capacity);
+        b = generator.elements(this->capacity);
+        // an inversion batch must not contain zero
+        for (auto& w : a) w[0] |= 1;
+        c.resize(this->capacity);
+        for (size_t i = 0; i < this->capacity; ++i) {
+            palindromicA.push_back(PalindromicMultiplier::toPalindromic(a[i]));
+            palindromicB.push_back(PalindromicMultiplier::toPalindromic(b[i]));
+            elementsA.push_back(GF2mElement::fromWords(a[i]));
+            elementsB.push_back(GF2mElement::fromWords(b[i]));
+            doubledA.emplace_back(a[i]);
+            doubledB.emplace_back(b[i]);
+        }
+        palindromicC.resize(this->capacity);
+        elementsC.assign(this->capacity, GF2mElement::zero());
+        doubledC.resize(this->capacity);
+        for (int i = 0; i < GF2mElement::getM(); ++i) exponent.push_back(rng() & 1 ? '1' : '0');
+        addCurvePoints(rng);
+        addBackends();
+    }
+
+    const std::vector<Backend>& getBackends() const { return backends; }
+    const EnergyMeter& getMeter() const { return meter; }
+
+    // 1, 2, 4, ... up to maxThreads, and maxThreads itself
+    static std::vector<int> threadCounts(int maxThreads) {
+        std::vector<int> counts;
+        for (int t = 1; t < maxThreads; t *= 2) counts.push_back(t);
+        counts.push_back(std::max(1, maxThreads));
+        return counts;
+    }
+
+    // 1, 10, 100, ... up to the capacity, and the capacity itself
+    std::vector<size_t> batchSizes() const {
+        std::vector<size_t> sizes;
+        for (size_t n = 1; n < capacity; n *= 10) sizes.push_back(n);
+        sizes.push_back(capacity);
+        return sizes;
+    }
+
+    std::vector<BenchmarkResult> sweep(int maxThreads, double minSeconds,
+                                       const std::function<void(const BenchmarkResult&)>& progress = nullptr) const {
+        std::vector<std::unique_ptr<ForkJoinGroup>> groups;
+        for (int t : threadCounts(maxThreads)) groups.push_back(std::make_unique<ForkJoinGroup>(t));
+
+        std::vector<BenchmarkResult> results;
+        for (const Backend& backend : backends) {
+            for (size_t batch : batchSizes()) {
+                if (batch > backend.maxBatch) continue;
+                double single = 0;
+                for (auto& group : groups) {
+                    BenchmarkResult result = measure(backend, *group, batch, minSeconds);
+                    if (result.threads == 1) single = result.opsPerSecond;
+                    result.speedup = single > 0 ? result.opsPerSecond / single : 1;
+                    result.efficiency = result.speedup / result.threads;
+                    if (progress) progress(result);
+                    results.push_back(result);
+                }
+            }
+        }
+        return results;
+    }
+
+    static void writeCsv(std::ostream& os, const std::vector<BenchmarkResult>& results) {
+        os << "backend,operation,threads,batch,seconds,ops,ops_per_second,speedup,efficiency,bytes_per_second,"
+              "joules,joules_per_op,ops_per_joule\n";
+        for (const auto& r : results) {
+            os << r.backend << "," << r.operation << "," << r.threads << "," << r.batch << "," << r.seconds << ","
+               << r.ops << "," << r.opsPerSecond << "," << r.speedup << "," << r.efficiency << "," << r.bytesPerSecond;
+            if (r.energy) os << "," << r.joules << "," << r.joulesPerOp << "," << r.opsPerJoule << "\n";
+            else os << ",,,\n";
+        }
+    }
+
+    static void writeJson(std::ostream& os, const std::vector<BenchmarkResult>& results) {
+        os << "[\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& r = results[i];
+            os << "  {\"backend\": \"" << r.backend << "\", \"operation\": \"" << r.operation << "\", \"threads\": "
+               << r.threads << ", \"batch\": " << r.batch << ", \"seconds\": " << r.seconds << ", \"ops\": " << r.ops
+               << ", \"ops_per_second\": " << r.opsPerSecond << ", \"speedup\": " << r.speedup
+               << ", \"efficiency\": " << r.efficiency << ", \"bytes_per_second\": " << r.bytesPerSecond;
+            if (r.energy) {
+                os << ", \"joules\": " << r.joules << ", \"joules_per_op\": " << r.joulesPerOp
+                   << ", \"ops_per_joule\": " << r.opsPerJoule;
+            } else {
+                os << ", \"joules\": null, \"joules_per_op\": null, \"ops_per_joule\": null";
+            }
+            os << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        os << "]\n";
+    }
+};
+
+#endif //LW4_SCALABILITYBENCHMARK_H
@@ -1,238 +1,13 @@
-#include <vector>
 #include <string>
 #include <iostream>
-#include <cmath>
 #include <chrono>
-#include <unordered_map>
-
-class GF2mElement {
-private:
-    std::vector<bool> coefficients;
-    static const int m = 233;
-    static const int p = 467;
-    static std::vector<std::vector<int>> nonZeroColumns;
-    static std::unordered_map<int, int> mod_pow_2_cache;
-
-public:
-    GF2mElement(const std::vector<bool>& coeffs) : coefficients(coeffs) {
-        coefficients.resize(m, false);
-    }
-
-    GF2mElement(const std::string& bitString) {
-        for (int i = bitString.length() - 1; i >= 0; --i) {
-            coefficients.push_back(bitString[i] == '1');
-        }
-        coefficients.resize(m, false);
-    }
-
-    GF2mElement operator+(const GF2mElement& other) const {
-        std::vector<bool> result_coeffs(m);
-        for (int i = 0; i < m; ++i) {
-            result_coeffs[i] = coefficients[i] ^ other.coefficients[i];
-        }
-        return GF2mElement(result_coeffs);
-    }
-
-    GF2mElement squareONB() const {
-        std::vector<bool> squared_coeffs(m);
-        squared_coeffs[m - 1] = coefficients[0];
-        for (int i = 0; i < m - 1; ++i) {
-            squared_coeffs[i] = coefficients[i + 1];
-        }
-        return GF2mElement(squared_coeffs);
-    }
-
-    bool trace() const {
-        bool trace_value = false;
-        for (bool coeff : coefficients) {
-            trace_value ^= coeff;
-        }
-        return trace_value;
-    }
-
-    friend std::ostream& operator<<(std::ostream& os, const GF2mElement& element) {
-        for (int i = m - 1; i >= 0; --i) {
-            os << (element.coefficients[i] ? '1' : '0');
-        }
-        return os;
-    }
-
-    static int mod_pow_2(int exponent, int mod) {
-        if (mod_pow_2_cache.find(exponent) != mod_pow_2_cache.end()) {
-            return mod_pow_2_cache[exponent];
-        }
-
-        int result = 1;
-        for (int i = 0; i < exponent; ++i) {
-            result = (result * 2) % mod;
-        }
-
-        mod_pow_2_cache[exponent] = result;
-        return result;
-    }
-
-    static int compute_matrix_element(int i, int j) {
-        int mod = p;
-        int pow_i = mod_pow_2(i, mod);
-        int pow_j = mod_pow_2(j, mod);
-
-        int results[] = {
-                (pow_i + pow_j) % mod,
-                (pow_i - pow_j + mod) % mod,
-                (-pow_i + pow_j + mod) % mod,
-                (-pow_i - pow_j + mod) % mod
-        };
-
-        for (int result : results) {
-            if (result == 1 || result == -466) return 1;
-        }
-
-        return 0;
-    }
-
-    static std::vector<std::pair<int, int>> createMultiplicativeMatrix() {
-        std::vector<std::pair<int, int>> one_positions;
-        char prevVal = 0;
-        for (int i = 0; i < m; ++i) {
-            prevVal = 0;
-            for (int j = 0; j < m; ++j) {
-                if (compute_matrix_element(i, j) == 1) {
-                    one_positions.emplace_back(i, j);
-                    prevVal++;
-                    if (prevVal == 2) break;
-                }
-            }
-        }
-
-        return one_positions;
-    }
-
-    std::vector<bool> transposeToVector() const {
-        std::vector<bool> transposed_vector(m);
-        for (int i = 0; i < m; ++i) {
-            transposed_vector[i] = coefficients[m - 1 - i];
-        }
-        return transposed_vector;
-    }
-
-    static void printMatrix(const std::vector<std::vector<bool>>& matrix) {
-        for (const auto& row : matrix) {
-            for (bool val : row) {
-                std::cout << val << " ";
-            }
-            std::cout << "\n";
-        }
-    }
-
-    std::vector<bool> multiplyWithMatrix(const std::vector<std::pair<int, int>>& one_positions) const {
-        std::vector<bool> result(m, false);
-        for (const auto& [i, j] : one_positions) {
-            bool temp = result[i] ^ coefficients[m - 1 - j];
-            result[i] = temp;
-        }
-        return result;
-    }
-
-    bool multiplyWithTransposed(const std::vector<bool>& other) const {
-        bool result = false;
-        for (int i = 0; i < m; ++i) {
-            if (other[i]) {
-                result ^= coefficients[i];
-            }
-        }
-        return result;
-    }
-
-    GF2mElement cyclicLeftShift(int positions) const {
-        int size = coefficients.size();
-        std::vector<bool> shifted_coeffs(size);
-
-        for (int i = 0; i < size; ++i) {
-            int new_index = (i + positions) % size;
-            shifted_coeffs[new_index] = coefficients[i];
-        }
-
-        return GF2mElement(shifted_coeffs);
-    }
-
-    void print() const {
-        for (int i = m - 1; i >= 0; --i) {
-            std::cout << (coefficients[i] ? '1' : '0');
-        }
-        std::cout << std::endl;
-    }
-
-    static std::string multiplyAndShift(GF2mElement a, GF2mElement b, int steps) {
-        std::vector<std::pair<int, int>> matrixA = createMultiplicativeMatrix();
-        std::string resultVector;
-
-        for (int step = 0; step < steps; ++step) {
-            std::vector<bool> productWithA = a.multiplyWithMatrix(matrixA);
-            std::vector<bool> transposedB = b.transposeToVector();
-            bool multiplicationResult = GF2mElement(productWithA).multiplyWithTransposed(transposedB);
-            resultVector.push_back(multiplicationResult ? '1' : '0');
-
-            a = a.cyclicLeftShift(1);
-            b = b.cyclicLeftShift(1);
-        }
-
-        return resultVector;
-    }
-
-    GF2mElement operator*(const GF2mElement& other) const {
-        std::string result = multiplyAndShift(*this, other, 233);
-        std::vector<bool> result_vector;
-        for (auto it = result.rbegin(); it != result.rend(); ++it) {
-            result_vector.push_back(*it == '1');
-        }
-        return GF2mElement(result_vector);
-    }
-
-    GF2mElement power(const std::string& exponent) const {
-        std::vector<bool> neutral_coeffs(m, true);
-        GF2mElement result(neutral_coeffs);
-        GF2mElement base = *this;
-
-        if (!exponent.empty() && exponent[0] == '1') {
-            result = result * base;
-        }
-
-        for (size_t i = 1; i < exponent.length(); ++i) {
-            result = result.squareONB();
-            if (exponent[i] == '1') {
-                result = result * base;
-            }
-
-        }
-        return result;
-    }
-
-    GF2mElement inverse() const {
-        GF2mElement beta = *this;
-        int k = 1;
-        std::string m_binary = "11101000"; // m - 1= 232
-
-        for (int i = 1; i <= 7; ++i) {
-            GF2mElement original_beta = beta;
-            for (int j = 0; j < k; ++j) {
-                beta = beta.squareONB();
-            }
-            beta = beta * original_beta;
-            k *= 2;
-
-            if (m_binary[i] == '1') {
-                GF2mElement squared_beta = beta.squareONB();
-                beta = squared_beta * (*this);
-                ++k;
-            }
-        }
-        beta = beta.squareONB();
-        return beta;
-    }
-
-};
-
-std::unordered_map<int, int> GF2mElement::mod_pow_2_cache;
+#include "GF2mElement.h"
+#include "EtaTPairing.h"
+#include "PohligHellman.h"
+#include "BasisConversion.h"
+#include "BinaryEdwards.h"
+#include "KoblitzCurve.h"
+#include "Nist233.h"
 
 int main() {
 
@@ -286,7 +61,94 @@ int main() {
     auto stop_pow = std::chrono::high_resolution_clock::now();
     auto duration_pow = std::chrono::duration_cast<std::chrono::microseconds>(stop_pow - start_pow);
     std::cout << "a^N : " << a_pow << std::endl;
-    std::cout << "Time: " << duration_pow.count() << " microseconds" << std::endl;
+    std::cout << "Time: " << duration_pow.count() << " microseconds" << std::endl << std::endl;
+
+    SupersingularCurve curve(1);
+    EtaTPairing eta(curve);
+    SupersingularPoint P, Q;
+    GF2mElement xP = a, xQ = b;
+    while (!curve.liftX(xP, P)) xP = xP.squareONB() + a;
+    while (!curve.liftX(xQ, Q)) xQ = xQ.squareONB() + b;
+
+    auto start_pair = std::chrono::high_resolution_clock::now();
+    GF2m4Element e_PQ = eta.pair(P, Q);
+    auto stop_pair = std::chrono::high_resolution_clock::now();
+    auto duration_pair = std::chrono::duration_cast<std::chrono::microseconds>(stop_pair - start_pair);
+    std::cout << "eta_T(P, Q): " << e_PQ << std::endl;
+    std::cout << "Time: " << duration_pair.count() << " microseconds" << std::endl << std::endl;
+
+    GF2mElement g = a.power(PohligHellman::cofactorExponent(1399));
+    GF2mElement h = g.power(PohligHellman::toBinary(777));
+    auto start_dlog = std::chrono::high_resolution_clock::now();
+    uint64_t dlog = PohligHellman::babyStepGiantStep(g, h, 1399);
+    auto stop_dlog = std::chrono::high_resolution_clock::now();
+    auto duration_dlog = std::chrono::duration_cast<std::chrono::microseconds>(stop_dlog - start_dlog);
+    std::cout << "log_g(g^777) in subgroup of order 1399: " << dlog << std::endl;
+    std::cout << "Time: " << duration_dlog.count() << " microseconds" << std::endl << std::endl;
+
+    std::vector<GF2mElement> batch = {a, b, c, product, inverse_element, a_squared, a_pow, g};
+    BasisConversion::normalToPolynomial();
+    auto start_conv = std::chrono::high_resolution_clock::now();
+    auto polynomial = BasisConversion::toPolynomial(batch);
+    auto stop_conv = std::chrono::high_resolution_clock::now();
+    auto duration_conv = std::chrono::duration_cast<std::chrono::microseconds>(stop_conv - start_conv);
+    bool round_trip = (BasisConversion::fromPolynomial(polynomial)[0] + a).isZero();
+    std::cout << "Polynomial basis conversion of " << batch.size() << " elements ("
+              << BitMatrix::kernelName(BitMatrix::kernel()) << "), round trip " << (round_trip ? "ok" : "failed") << std::endl;
+    std::cout << "Time: " << duration_conv.count() << " microseconds" << std::endl << std::endl;
+
+    BinaryCurve<GF2mElement> k233 = BinaryCurve<GF2mElement>::koblitz(0);
+    BinaryEdwardsCurve<GF2mElement> edwards(GF2mElement::one(), GF2mElement::one());
+    BinaryEdwardsCurve<GF2mElement>::fromWeierstrassCurve(k233, a, edwards);
+    std::vector<GF2mElement> ws;
+    GF2mElement xK = b;
+    while (ws.size() < GF2mBitsliced::LANES) {
+        BinaryPoint<GF2mElement> K;
+        if (k233.liftX(xK, K)) {
+            EdwardsPoint<GF2mElement> E = edwards.fromWeierstrass(K);
+            ws.push_back(E.x + E.y);
+        }
+        xK = xK.squareONB() + a;
+    }
+    std::vector<std::string> scalars(ws.size(), N);
+    auto start_ladder = std::chrono::high_resolution_clock::now();
+    std::vector<GF2mElement> ladder = edwards.batchLadder(ws, scalars);
+    auto stop_ladder = std::chrono::high_resolution_clock::now();
+    auto duration_ladder = std::chrono::duration_cast<std::chrono::microseconds>(stop_ladder - start_ladder);
+    bool ladder_ok = (edwards.ladder(ws[0], N) + ladder[0]).isZero();
+    std::cout << "Bitsliced Edwards ladder on K-233, " << ws.size() << " points, lane 0 "
+              << (ladder_ok ? "ok" : "failed") << std::endl;
+    std::cout << "Time: " << duration_ladder.count() << " microseconds" << std::endl << std::endl;
+
+    BinaryCurve<GF2mElement> b233 = Nist233::b233();
+    BinaryPoint<GF2mElement> GB = Nist233::b233Generator();
+    BinaryEdwardsCurve<GF2mElement> edwardsB(GF2mElement::one(), GF2mElement::one());
+    bool b233_ok = b233.isOnCurve(GB) && b233.multiply(GB, Nist233::b233Order()).infinity &&
+                   BinaryEdwardsCurve<GF2mElement>::fromWeierstrassCurve(b233, a, edwardsB);
+    EdwardsPoint<GF2mElement> EB = edwardsB.fromWeierstrass(GB);
+    BinaryPoint<GF2mElement> GB_back = edwardsB.toWeierstrass(EB);
+    EdwardsPoint<GF2mElement> NB = edwardsB.fromWeierstrass(b233.multiply(GB, N));
+    b233_ok = b233_ok && edwardsB.isOnCurve(EB) && GB_back.x == GB.x && GB_back.y == GB.y &&
+              edwardsB.ladder(EB.x + EB.y, N) == NB.x + NB.y;
+    std::cout << "B-233 base point through the Edwards model (map, round trip, ladder): "
+              << (b233_ok ? "ok" : "failed") << std::endl << std::endl;
+
+    KoblitzCurve<GF2mElement> koblitz(0);
+    BinaryPoint<GF2mElement> G, Qk;
+    GF2mElement xG = a;
+    while (!k233.liftX(xG, G)) xG = xG.squareONB() + b;
+    G = k233.multiply(G, uint64_t(4));
+    Qk = k233.multiply(G, N);
+    auto table = koblitz.precompute(G);
+    std::string u1 = N, u2(N.rbegin(), N.rend());
+    auto start_double = std::chrono::high_resolution_clock::now();
+    BinaryPoint<GF2mElement> R = koblitz.doubleMultiply(u1, table, u2, Qk);
+    auto stop_double = std::chrono::high_resolution_clock::now();
+    auto duration_double = std::chrono::duration_cast<std::chrono::microseconds>(stop_double - start_double);
+    BinaryPoint<GF2mElement> R_ref = k233.add(k233.multiply(G, u1), k233.multiply(Qk, u2));
+    bool double_ok = (R.x + R_ref.x).isZero() && (R.y + R_ref.y).isZero();
+    std::cout << "u1 G + u2 Q on K-233 (tau-adic, fixed-base G): " << (double_ok ? "ok" : "failed") << std::endl;
+    std::cout << "Time: " << duration_double.count() << " microseconds" << std::endl;
 
     return 0;
 }
\ No newline at end of file